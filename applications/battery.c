@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <battery.h>
+#include <rate_group.h>
+
+#define DBG_SECTION_NAME  "batt"
+#define DBG_LEVEL         DBG_LOG
+#include <rtdbg.h>
+
+#ifdef RT_USING_ADC
+
+static rt_adc_device_t batt_adc = RT_NULL;
+static struct rate_stage batt_stage;
+static struct rt_event batt_event;
+
+static rt_uint32_t batt_raw = 0;
+static rt_uint32_t batt_filter = 0;             /* mV << BATTERY_FILTER_SHIFT */
+static rt_uint32_t batt_mv = BATTERY_NOMINAL_MV;
+static float batt_scale = 1.0f;
+static rt_bool_t batt_low = RT_FALSE;
+
+static void battery_sample(void *parameter)
+{
+    rt_uint32_t mv;
+
+    batt_raw = rt_adc_read(batt_adc, BATTERY_ADC_CHANNEL);
+    mv = batt_raw * BATTERY_ADC_VREF_MV * BATTERY_DIVIDER_RATIO / BATTERY_ADC_MAX;
+
+    /* seed the filter with the first sample */
+    if (batt_filter == 0)
+        batt_filter = mv << BATTERY_FILTER_SHIFT;
+    else
+        batt_filter = batt_filter - (batt_filter >> BATTERY_FILTER_SHIFT) + mv;
+    batt_mv = batt_filter >> BATTERY_FILTER_SHIFT;
+
+    if (batt_mv > 0)
+    {
+        float scale = (float)BATTERY_NOMINAL_MV / (float)batt_mv;
+
+        batt_scale = (scale > BATTERY_SCALE_MAX) ? BATTERY_SCALE_MAX : scale;
+    }
+
+    if (!batt_low && batt_mv < BATTERY_LOW_MV)
+    {
+        batt_low = RT_TRUE;
+        rt_event_send(&batt_event, BATTERY_EVENT_LOW);
+    }
+    else if (batt_low && batt_mv > BATTERY_RECOVER_MV)
+    {
+        batt_low = RT_FALSE;
+        rt_event_send(&batt_event, BATTERY_EVENT_OK);
+    }
+}
+
+rt_err_t battery_init(void)
+{
+    rt_event_init(&batt_event, "batt", RT_IPC_FLAG_FIFO);
+
+    batt_adc = (rt_adc_device_t)rt_device_find(BATTERY_ADC_DEVICE);
+    if (batt_adc == RT_NULL)
+    {
+        LOG_W("%s not found, battery compensation disabled", BATTERY_ADC_DEVICE);
+        return -RT_ENOSYS;
+    }
+    rt_adc_enable(batt_adc, BATTERY_ADC_CHANNEL);
+
+    rate_stage_init(&batt_stage, "battery", battery_sample, RT_NULL);
+
+    return rate_stage_register(&batt_stage, BATTERY_SAMPLE_HZ, BATTERY_PRIORITY);
+}
+
+rt_uint32_t battery_voltage(void)
+{
+    return batt_mv;
+}
+
+float battery_compensation(void)
+{
+    return batt_scale;
+}
+
+rt_int32_t battery_scale_duty(rt_int32_t duty, rt_int32_t limit)
+{
+    rt_int32_t scaled = (rt_int32_t)(duty * batt_scale);
+
+    if (scaled > limit)
+        scaled = limit;
+    else if (scaled < -limit)
+        scaled = -limit;
+
+    return scaled;
+}
+
+rt_event_t battery_event(void)
+{
+    return &batt_event;
+}
+
+static void battery(int argc, char *argv[])
+{
+    rt_kprintf("battery: %u mV (raw %u), compensation %d.%03d%s\n",
+               batt_mv, batt_raw, (int)batt_scale, (int)(batt_scale * 1000) % 1000,
+               batt_low ? ", LOW" : "");
+}
+MSH_CMD_EXPORT(battery, show battery voltage and motor compensation);
+
+#endif /* RT_USING_ADC */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#ifndef __BATTERY_H__
+#define __BATTERY_H__
+
+#include <rtthread.h>
+
+/*
+ * Supply monitor
+ *
+ * Samples the battery through an ADC channel behind a resistor divider as a
+ * rate-group stage, low-pass filters it, and derives the feedforward factor
+ * nominal / actual voltage used to keep motor torque independent of sag.
+ * Crossing the low-voltage threshold (with hysteresis) sends an event.
+ */
+
+#define BATTERY_ADC_DEVICE          "adc1"
+#ifdef BSP_ADC1_BATTERY_CHANNEL
+#define BATTERY_ADC_CHANNEL         BSP_ADC1_BATTERY_CHANNEL
+#else
+#define BATTERY_ADC_CHANNEL         14          /* PC5, the analog pin of the board */
+#endif
+#define BATTERY_ADC_MAX             4095
+#define BATTERY_ADC_VREF_MV         3300
+#define BATTERY_DIVIDER_RATIO       3           /* Vbat = Vadc * ratio */
+
+#define BATTERY_NOMINAL_MV          7400        /* 2-cell pack */
+#define BATTERY_LOW_MV              6600
+#define BATTERY_RECOVER_MV          6900
+
+#define BATTERY_FILTER_SHIFT        3           /* exponential filter, alpha = 1/8 */
+#define BATTERY_SCALE_MAX           1.5f
+
+#define BATTERY_SAMPLE_HZ           50
+#define BATTERY_PRIORITY            12
+
+#define BATTERY_EVENT_LOW           (1 << 0)
+#define BATTERY_EVENT_OK            (1 << 1)
+
+rt_err_t battery_init(void);
+
+rt_uint32_t battery_voltage(void);
+float battery_compensation(void);
+rt_int32_t battery_scale_duty(rt_int32_t duty, rt_int32_t limit);
+rt_event_t battery_event(void);
+
+#endif
@@ -5,6 +5,10 @@
 #include <dual_pwm_motor.h>
 #include <ab_phase_encoder.h>
 #include <inc_pid_controller.h>
+#include <rate_group.h>
+#include <probe.h>
+#include <recorder.h>
+#include <battery.h>
 
 #define DBG_SECTION_NAME  "car"
 #define DBG_LEVEL         DBG_LOG
@@ -51,67 +55,86 @@ chassis_t chas;
 #define PS2_DO_PIN                   4
 #define PS2_DI_PIN                  36
 
-// Car Thread
-#define THREAD_PRIORITY             10
-#define THREAD_STACK_SIZE          512
-#define THREAD_TIMESLICE             5
+// Rate groups
+#define CONTROL_RATE_HZ             (RT_TICK_PER_SECOND / PID_SAMPLE_TIME)
+#define CONTROL_PRIORITY            10
 
-static rt_thread_t tid_car = RT_NULL;
+static struct rate_stage control_stage;
+static struct probe chassis_probe = PROBE_INIT("chassis");
 
-void car_thread(void *param)
+static void car_control_stage(void *param)
 {
-    // TODO
+    recorder_cycle();
 
-    struct velocity target_velocity;
-
-    target_velocity.linear_x = 0.00f;
-    target_velocity.linear_y = 0;
-    target_velocity.angular_z = 0;
-    chassis_set_velocity(chas, target_velocity);
+    PROBE_BEGIN(chassis_probe);
+    chassis_update((chassis_t)param);
+    PROBE_END(chassis_probe);
+}
 
-    // Open-loop control
-    // controller_disable(chas->c_wheels[0]->w_controller);
-    // controller_disable(chas->c_wheels[1]->w_controller);
+// Chassis description, fixed at compile time
+struct car_wheel_desc
+{
+    const char *forward_pwm;
+    int         forward_channel;
+    const char *backward_pwm;
+    int         backward_channel;
+    rt_base_t   encoder_a_pin;
+    rt_base_t   encoder_b_pin;
+};
+
+static const struct car_wheel_desc car_wheel_descs[] =
+{
+    {LEFT_FORWARD_PWM,  LEFT_FORWARD_PWM_CHANNEL,  LEFT_BACKWARD_PWM,  LEFT_BACKWARD_PWM_CHANNEL,  LEFT_ENCODER_A_PHASE_PIN,  LEFT_ENCODER_B_PHASE_PIN},
+    {RIGHT_FORWARD_PWM, RIGHT_FORWARD_PWM_CHANNEL, RIGHT_BACKWARD_PWM, RIGHT_BACKWARD_PWM_CHANNEL, RIGHT_ENCODER_A_PHASE_PIN, RIGHT_ENCODER_B_PHASE_PIN},
+};
 
-    while (1)
-    {
-        rt_thread_mdelay(ENCODER_SAMPLE_TIME);
-        chassis_update(chas);
-    }
+#define CAR_WHEEL_NUM               (sizeof(car_wheel_descs) / sizeof(car_wheel_descs[0]))
 
-//    chassis_destroy(chas);
-}
+static wheel_t c_wheels[CAR_WHEEL_NUM];
 
 void car_init(void *parameter)
 {
-    // 1. Initialize two wheels - left and right
-    wheel_t* c_wheels = (wheel_t*) rt_malloc(sizeof(wheel_t) * 2);
-    if (c_wheels == RT_NULL)
+    rt_size_t i;
+
+    // 1. Initialize the wheels from the chassis description
+    for (i = 0; i < CAR_WHEEL_NUM; i++)
     {
-        LOG_D("Failed to malloc memory for wheels");
+        const struct car_wheel_desc *desc = &car_wheel_descs[i];
+
+        // 1.1 Motor, encoder and pid controller of the wheel
+        dual_pwm_motor_t motor = dual_pwm_motor_create(desc->forward_pwm, desc->forward_channel, desc->backward_pwm, desc->backward_channel);
+        ab_phase_encoder_t encoder = ab_phase_encoder_create(desc->encoder_a_pin, desc->encoder_b_pin, PULSE_PER_REVOL, ENCODER_SAMPLE_TIME);
+        inc_pid_controller_t pid = inc_pid_controller_create(PID_PARAM_KP, PID_PARAM_KI, PID_PARAM_KD, PID_SAMPLE_TIME);
+        if (motor == RT_NULL || encoder == RT_NULL || pid == RT_NULL)
+        {
+            LOG_E("Failed to create wheel %d", i);
+            return;
+        }
+
+        // 1.2 Add the wheel
+        c_wheels[i] = wheel_create((motor_t)motor, (encoder_t)encoder, (controller_t)pid, WHEEL_RADIUS, GEAR_RATIO);
+        if (c_wheels[i] == RT_NULL)
+        {
+            LOG_E("Failed to create wheel %d", i);
+            return;
+        }
     }
 
-    // 1.1 Create two motors
-    dual_pwm_motor_t left_motor   = dual_pwm_motor_create(LEFT_FORWARD_PWM, LEFT_FORWARD_PWM_CHANNEL, LEFT_BACKWARD_PWM, LEFT_BACKWARD_PWM_CHANNEL);
-    dual_pwm_motor_t right_motor  = dual_pwm_motor_create(RIGHT_FORWARD_PWM, RIGHT_FORWARD_PWM_CHANNEL, RIGHT_BACKWARD_PWM, RIGHT_BACKWARD_PWM_CHANNEL);
-
-    // 1.2 Create two encoders
-    ab_phase_encoder_t left_encoder  = ab_phase_encoder_create(LEFT_ENCODER_A_PHASE_PIN, LEFT_ENCODER_B_PHASE_PIN, PULSE_PER_REVOL, ENCODER_SAMPLE_TIME);
-    ab_phase_encoder_t right_encoder = ab_phase_encoder_create(RIGHT_ENCODER_A_PHASE_PIN, RIGHT_ENCODER_B_PHASE_PIN, PULSE_PER_REVOL, ENCODER_SAMPLE_TIME);
-
-    // 1.3 Create two pid contollers
-    inc_pid_controller_t left_pid  = inc_pid_controller_create(PID_PARAM_KP, PID_PARAM_KI, PID_PARAM_KD, PID_SAMPLE_TIME);
-    inc_pid_controller_t right_pid = inc_pid_controller_create(PID_PARAM_KP, PID_PARAM_KI, PID_PARAM_KD, PID_SAMPLE_TIME);
-
-    // 1.4 Add two wheels
-    c_wheels[0] = wheel_create((motor_t)left_motor,  (encoder_t)left_encoder,  (controller_t)left_pid,  WHEEL_RADIUS, GEAR_RATIO);
-    c_wheels[1] = wheel_create((motor_t)right_motor, (encoder_t)right_encoder, (controller_t)right_pid, WHEEL_RADIUS, GEAR_RATIO);
-
     // 2. Iinialize Kinematics - Two Wheel Differential Drive
     kinematics_t c_kinematics = kinematics_create(TWO_WD, WHEEL_DIST_X, WHEEL_DIST_Y, WHEEL_RADIUS);
+    if (c_kinematics == RT_NULL)
+    {
+        LOG_E("Failed to create kinematics");
+        return;
+    }
 
     // 3. Initialize Chassis
     chas = chassis_create(c_wheels, c_kinematics);
+    if (chas == RT_NULL)
+    {
+        LOG_E("Failed to create chassis");
+        return;
+    }
 
     // 4. Enable Chassis
     chassis_enable(chas);
@@ -121,14 +144,26 @@ void car_init(void *parameter)
 
     ps2_init(PS2_CS_PIN, PS2_CLK_PIN, PS2_DO_PIN, PS2_DI_PIN);
 
-    // thread
-    tid_car = rt_thread_create("tcar",
-                              car_thread, RT_NULL,
-                              THREAD_STACK_SIZE,
-                              THREAD_PRIORITY, THREAD_TIMESLICE);
+    // Start from standstill
+    struct velocity target_velocity;
 
-    if (tid_car != RT_NULL)
-    {
-        rt_thread_startup(tid_car);
-    }
+    target_velocity.linear_x = 0.00f;
+    target_velocity.linear_y = 0;
+    target_velocity.angular_z = 0;
+    chassis_set_velocity(chas, target_velocity);
+
+    // Open-loop control
+    // controller_disable(chas->c_wheels[0]->w_controller);
+    // controller_disable(chas->c_wheels[1]->w_controller);
+
+    // 5. Register control stages and start the rate-group executor
+    rate_stage_init(&control_stage, "chassis", car_control_stage, chas);
+    rate_stage_register(&control_stage, CONTROL_RATE_HZ, CONTROL_PRIORITY);
+
+#ifdef RT_USING_ADC
+    // Supply monitoring for motor feedforward
+    battery_init();
+#endif
+
+    rate_group_start();
 }
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <coro.h>
+
+#define DBG_SECTION_NAME  "coro"
+#define DBG_LEVEL         DBG_LOG
+#include <rtdbg.h>
+
+#define CORO_EVENT_WAKE         0x01
+#define CORO_RX_MAX             4
+
+static rt_list_t coro_list = RT_LIST_OBJECT_INIT(coro_list);
+static struct rt_event coro_event;
+static struct rt_thread coro_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t coro_stack[CORO_STACK_SIZE];
+
+/* devices whose RX indication signals a coroutine */
+static struct
+{
+    rt_device_t device;
+    coro_t co;
+} coro_rx[CORO_RX_MAX];
+
+void coro_init(coro_t co, const char *name, int (*entry)(struct coro *co), void *parameter)
+{
+    RT_ASSERT(co != RT_NULL);
+    RT_ASSERT(entry != RT_NULL);
+
+    rt_list_init(&(co->list));
+    co->name         = name;
+    co->entry        = entry;
+    co->parameter    = parameter;
+    co->lc           = 0;
+    co->wait         = 0;
+    co->signaled     = 0;
+    co->object       = RT_NULL;
+    co->timeout_tick = 0;
+    co->resumes      = 0;
+}
+
+rt_err_t coro_start(coro_t co)
+{
+    rt_base_t level;
+
+    RT_ASSERT(co != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    if (!rt_list_isempty(&(co->list)))
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EBUSY;
+    }
+    co->lc   = 0;
+    co->wait = 0;
+    rt_list_insert_before(&coro_list, &(co->list));
+    rt_hw_interrupt_enable(level);
+
+    rt_event_send(&coro_event, CORO_EVENT_WAKE);
+
+    return RT_EOK;
+}
+
+/* may be called from interrupt context */
+void coro_signal(coro_t co)
+{
+    co->signaled = 1;
+    rt_event_send(&coro_event, CORO_EVENT_WAKE);
+}
+
+static rt_err_t coro_rx_ind(rt_device_t device, rt_size_t size)
+{
+    int i;
+
+    for (i = 0; i < CORO_RX_MAX; i++)
+    {
+        if (coro_rx[i].device == device)
+        {
+            coro_signal(coro_rx[i].co);
+            break;
+        }
+    }
+
+    return RT_EOK;
+}
+
+rt_err_t coro_attach_rx(coro_t co, rt_device_t device)
+{
+    int i;
+
+    for (i = 0; i < CORO_RX_MAX; i++)
+    {
+        if (coro_rx[i].device == RT_NULL || coro_rx[i].device == device)
+        {
+            coro_rx[i].co     = co;
+            coro_rx[i].device = device;
+
+            return rt_device_set_rx_indicate(device, coro_rx_ind);
+        }
+    }
+
+    LOG_E("No free RX slot for %s", co->name);
+    return -RT_EFULL;
+}
+
+void coro_wait_prepare(coro_t co, rt_uint8_t wait, struct rt_object *object, rt_int32_t ticks)
+{
+    rt_base_t level;
+
+    if (ticks != RT_WAITING_FOREVER)
+    {
+        wait |= CORO_ON_TIMEOUT;
+        co->timeout_tick = rt_tick_get() + ticks;
+    }
+
+    /* coro_post reads these with interrupts disabled */
+    level = rt_hw_interrupt_disable();
+    co->object = object;
+    co->wait   = wait;
+    rt_hw_interrupt_enable(level);
+}
+
+rt_bool_t coro_timed_out(coro_t co)
+{
+    if (!(co->wait & CORO_ON_TIMEOUT))
+        return RT_FALSE;
+
+    return (rt_tick_get() - co->timeout_tick) < RT_TICK_MAX / 2;
+}
+
+rt_bool_t coro_take_signal(coro_t co)
+{
+    rt_base_t level;
+    rt_bool_t signaled;
+
+    level = rt_hw_interrupt_disable();
+    signaled = co->signaled;
+    co->signaled = 0;
+    rt_hw_interrupt_enable(level);
+
+    return signaled;
+}
+
+/* may be called from interrupt context */
+void coro_post(struct rt_object *object)
+{
+    coro_t co;
+    rt_base_t level;
+    rt_list_t *node;
+    rt_bool_t wake = RT_FALSE;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_for_each(node, &coro_list)
+    {
+        co = rt_list_entry(node, struct coro, list);
+        if ((co->wait & CORO_ON_IPC) && co->object == object)
+        {
+            wake = RT_TRUE;
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (wake)
+        rt_event_send(&coro_event, CORO_EVENT_WAKE);
+}
+
+rt_err_t coro_sem_release(rt_sem_t sem)
+{
+    rt_err_t result;
+
+    result = rt_sem_release(sem);
+    coro_post(&(sem->parent.parent));
+
+    return result;
+}
+
+rt_err_t coro_event_send(rt_event_t event, rt_uint32_t set)
+{
+    rt_err_t result;
+
+    result = rt_event_send(event, set);
+    coro_post(&(event->parent.parent));
+
+    return result;
+}
+
+/* whether a waiting coroutine must be called on this pass */
+static rt_bool_t coro_runnable(coro_t co)
+{
+    /* IPC objects and plain conditions are checked on every pass */
+    if (co->wait == 0 || (co->wait & CORO_ON_IPC) || coro_timed_out(co))
+        return RT_TRUE;
+
+    return (co->wait & CORO_ON_SIGNAL) && co->signaled;
+}
+
+static void coro_thread_entry(void *parameter)
+{
+    coro_t co;
+    rt_base_t level;
+    rt_list_t *node, *next;
+    rt_int32_t sleep, left;
+    rt_uint32_t recved;
+
+    while (1)
+    {
+        sleep = RT_WAITING_FOREVER;
+
+        rt_list_for_each_safe(node, next, &coro_list)
+        {
+            co = rt_list_entry(node, struct coro, list);
+
+            if (coro_runnable(co))
+            {
+                co->resumes++;
+                switch (co->entry(co))
+                {
+                case CORO_YIELDED:
+                    co->wait = 0;
+                    break;
+
+                case CORO_EXITED:
+                    level = rt_hw_interrupt_disable();
+                    rt_list_remove(&(co->list));
+                    rt_hw_interrupt_enable(level);
+                    continue;
+
+                default:
+                    break;
+                }
+            }
+
+            /* the earliest point a coroutine needs the next pass */
+            if (co->wait == 0)
+                left = 0;
+            else if (co->wait & CORO_ON_TIMEOUT)
+                left = (rt_int32_t)(co->timeout_tick - rt_tick_get());
+            else if ((co->wait & CORO_ON_IPC) && co->object != RT_NULL)
+                left = CORO_POLL_TICKS;
+            else
+                continue;
+
+            /* a release without coro_post is seen on the next poll */
+            if ((co->wait & CORO_ON_IPC) && co->object != RT_NULL && left > CORO_POLL_TICKS)
+                left = CORO_POLL_TICKS;
+
+            if (left < 0)
+                left = 0;
+            if (sleep == RT_WAITING_FOREVER || left < sleep)
+                sleep = left;
+        }
+
+        rt_event_recv(&coro_event, CORO_EVENT_WAKE, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      sleep, &recved);
+    }
+}
+
+static int coro_system_init(void)
+{
+    rt_event_init(&coro_event, "coro", RT_IPC_FLAG_FIFO);
+    rt_thread_init(&coro_thread, "tcoro", coro_thread_entry, RT_NULL,
+                   coro_stack, CORO_STACK_SIZE,
+                   CORO_PRIORITY, CORO_TIMESLICE);
+    rt_thread_startup(&coro_thread);
+
+    return 0;
+}
+INIT_APP_EXPORT(coro_system_init);
+
+static void coro(int argc, char *argv[])
+{
+    coro_t co;
+    rt_list_t *node;
+
+    rt_kprintf("coroutine  wait resumes\n");
+    rt_kprintf("---------- ---- ----------\n");
+    rt_list_for_each(node, &coro_list)
+    {
+        co = rt_list_entry(node, struct coro, list);
+        rt_kprintf("%-10s 0x%02x %10u\n", co->name, co->wait, co->resumes);
+    }
+}
+MSH_CMD_EXPORT(coro, list coroutines);
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#ifndef __CORO_H__
+#define __CORO_H__
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+/*
+ * Stackless coroutines
+ *
+ * Many small robot behaviours run as coroutines on the single "tcoro"
+ * thread instead of each owning a thread and a stack. A coroutine is a
+ * function that is called again and again by the runtime; CORO_BEGIN() and
+ * CORO_END() wrap its body in a switch statement so that every wait point
+ * resumes at the line it returned from. Local variables do not survive a
+ * wait point, so keep the state in a structure holding the struct coro.
+ *
+ * Coroutines wait on timers, on the existing semaphores and events and on
+ * signals, e.g. from a device RX indication. The runtime thread blocks on its
+ * own event until the nearest timeout or a signal. A semaphore or event a
+ * coroutine waits on is checked again every CORO_POLL_TICKS; releasing it
+ * with coro_sem_release() or coro_event_send() wakes the waiter at once.
+ */
+
+#define CORO_STACK_SIZE         1024
+#define CORO_PRIORITY           20
+#define CORO_TIMESLICE          5
+/* the longest a waiter on an IPC object misses a plain release by */
+#define CORO_POLL_TICKS         ((RT_TICK_PER_SECOND + 99) / 100)
+
+/* return codes of a coroutine function */
+#define CORO_WAITING            0
+#define CORO_YIELDED            1
+#define CORO_EXITED             2
+
+/* what a waiting coroutine waits for */
+#define CORO_ON_TIMEOUT         0x01
+#define CORO_ON_IPC             0x02
+#define CORO_ON_SIGNAL          0x04
+
+struct coro
+{
+    rt_list_t list;
+
+    const char *name;
+    int (*entry)(struct coro *co);
+    void *parameter;
+
+    rt_uint16_t lc;                             /* line to resume at */
+    rt_uint8_t wait;                            /* CORO_ON_* flags */
+    volatile rt_uint8_t signaled;
+    struct rt_object *object;                   /* IPC object waited on */
+    rt_tick_t timeout_tick;
+
+    rt_uint32_t resumes;
+};
+typedef struct coro *coro_t;
+
+#define CORO_BEGIN(co)          switch ((co)->lc) { case 0:
+#define CORO_END(co)            } (co)->lc = 0; return CORO_EXITED
+
+/* resume point; the runtime calls the coroutine again at this line */
+#define CORO_LABEL(co)          (co)->lc = __LINE__; case __LINE__:
+
+/* give the other coroutines a turn */
+#define CORO_YIELD(co)                                                      \
+    do {                                                                    \
+        (co)->lc = __LINE__; return CORO_YIELDED; case __LINE__:;           \
+    } while (0)
+
+/*
+ * wait until cond is true, re-checked whenever the runtime wakes up; whoever
+ * makes cond true calls coro_signal() on the coroutine
+ */
+#define CORO_WAIT_UNTIL(co, cond)                                           \
+    do {                                                                    \
+        coro_wait_prepare(co, CORO_ON_IPC, RT_NULL, RT_WAITING_FOREVER);    \
+        CORO_LABEL(co)                                                      \
+        if (!(cond)) return CORO_WAITING;                                   \
+    } while (0)
+
+#define CORO_DELAY(co, ticks)                                               \
+    do {                                                                    \
+        coro_wait_prepare(co, CORO_ON_TIMEOUT, RT_NULL, ticks);             \
+        CORO_LABEL(co)                                                      \
+        if (!coro_timed_out(co)) return CORO_WAITING;                       \
+    } while (0)
+
+#define CORO_MDELAY(co, ms)     CORO_DELAY(co, rt_tick_from_millisecond(ms))
+
+/* take a semaphore, result is RT_EOK or -RT_ETIMEOUT */
+#define CORO_SEM_TAKE(co, sem, ticks, result)                               \
+    do {                                                                    \
+        coro_wait_prepare(co, CORO_ON_IPC, &(sem)->parent.parent, ticks);   \
+        CORO_LABEL(co)                                                      \
+        (result) = rt_sem_trytake(sem);                                     \
+        if ((result) != RT_EOK)                                             \
+        {                                                                   \
+            if (!coro_timed_out(co)) return CORO_WAITING;                   \
+            (result) = -RT_ETIMEOUT;                                        \
+        }                                                                   \
+    } while (0)
+
+/* receive an event, result is RT_EOK or -RT_ETIMEOUT */
+#define CORO_EVENT_RECV(co, event, set, option, ticks, recved, result)      \
+    do {                                                                    \
+        coro_wait_prepare(co, CORO_ON_IPC, &(event)->parent.parent, ticks); \
+        CORO_LABEL(co)                                                      \
+        (result) = rt_event_recv(event, set, option, 0, recved);            \
+        if ((result) != RT_EOK)                                             \
+        {                                                                   \
+            if (!coro_timed_out(co)) return CORO_WAITING;                   \
+            (result) = -RT_ETIMEOUT;                                        \
+        }                                                                   \
+    } while (0)
+
+/* wait for coro_signal(), result is RT_EOK or -RT_ETIMEOUT */
+#define CORO_WAIT_SIGNAL(co, ticks, result)                                 \
+    do {                                                                    \
+        coro_wait_prepare(co, CORO_ON_SIGNAL, RT_NULL, ticks);              \
+        CORO_LABEL(co)                                                      \
+        if (coro_take_signal(co))                                           \
+            (result) = RT_EOK;                                              \
+        else if (!coro_timed_out(co))                                       \
+            return CORO_WAITING;                                            \
+        else                                                                \
+            (result) = -RT_ETIMEOUT;                                        \
+    } while (0)
+
+void    coro_init(coro_t co, const char *name, int (*entry)(struct coro *co), void *parameter);
+rt_err_t coro_start(coro_t co);
+
+void coro_signal(coro_t co);
+rt_err_t coro_attach_rx(coro_t co, rt_device_t device);
+
+/* wake the coroutines waiting on object, after it has been released */
+void     coro_post(struct rt_object *object);
+rt_err_t coro_sem_release(rt_sem_t sem);
+rt_err_t coro_event_send(rt_event_t event, rt_uint32_t set);
+
+/* used by the wait macros */
+void      coro_wait_prepare(coro_t co, rt_uint8_t wait, struct rt_object *object, rt_int32_t ticks);
+rt_bool_t coro_timed_out(coro_t co);
+rt_bool_t coro_take_signal(coro_t co);
+
+#endif
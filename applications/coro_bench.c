@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rtthread.h>
+#include <coro.h>
+#include <probe.h>
+
+#define CORO_BENCH_ROUNDS       1000
+#define CORO_BENCH_STACK_SIZE   512             /* smallest stack of a robot thread */
+
+struct coro_bench_task
+{
+    struct coro co;
+    rt_uint32_t round;
+};
+
+static struct coro_bench_task bench_tasks[2];
+static struct rt_semaphore bench_done;
+static rt_uint32_t bench_start, bench_end;
+static rt_uint8_t bench_exited;
+
+static struct rt_thread bench_threads[2];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t bench_stacks[2][CORO_BENCH_STACK_SIZE];
+
+static int coro_bench_entry(struct coro *co)
+{
+    struct coro_bench_task *task = rt_container_of(co, struct coro_bench_task, co);
+
+    CORO_BEGIN(co);
+
+    if (bench_start == 0)
+        bench_start = probe_cycles();
+
+    for (task->round = 0; task->round < CORO_BENCH_ROUNDS; task->round++)
+        CORO_YIELD(co);
+
+    if (++bench_exited == 2)
+    {
+        bench_end = probe_cycles();
+        rt_sem_release(&bench_done);
+    }
+
+    CORO_END(co);
+}
+
+static void coro_bench_thread(void *parameter)
+{
+    int i;
+
+    if (bench_start == 0)
+        bench_start = probe_cycles();
+
+    for (i = 0; i < CORO_BENCH_ROUNDS; i++)
+        rt_thread_yield();
+
+    if (++bench_exited == 2)
+    {
+        bench_end = probe_cycles();
+        rt_sem_release(&bench_done);
+    }
+}
+
+/* stack bytes a thread has touched, from the '#' fill of rt_thread_init */
+static rt_uint32_t coro_bench_stack_used(struct rt_thread *thread)
+{
+    rt_uint8_t *ptr = (rt_uint8_t *)thread->stack_addr;
+
+    while (ptr < (rt_uint8_t *)thread->stack_addr + thread->stack_size && *ptr == '#')
+        ptr++;
+
+    return thread->stack_size - (ptr - (rt_uint8_t *)thread->stack_addr);
+}
+
+static void coro_bench(int argc, char *argv[])
+{
+    int i;
+    struct rt_thread *tcoro;
+    rt_uint32_t coro_switch, thread_switch;
+
+    rt_sem_init(&bench_done, "cbench", 0, RT_IPC_FLAG_FIFO);
+
+    /* two coroutines yielding to each other on the runtime thread */
+    bench_start = bench_exited = 0;
+    for (i = 0; i < 2; i++)
+    {
+        coro_init(&bench_tasks[i].co, "bench", coro_bench_entry, RT_NULL);
+        coro_start(&bench_tasks[i].co);
+    }
+    rt_sem_take(&bench_done, RT_WAITING_FOREVER);
+    coro_switch = (bench_end - bench_start) / (2 * CORO_BENCH_ROUNDS);
+
+    /* two threads of the same priority yielding to each other */
+    bench_start = bench_exited = 0;
+    for (i = 0; i < 2; i++)
+    {
+        rt_thread_init(&bench_threads[i], "tbench", coro_bench_thread, RT_NULL,
+                       bench_stacks[i], CORO_BENCH_STACK_SIZE, CORO_PRIORITY - 1, 10);
+    }
+    /* start both before either runs, or the first one yields to nobody */
+    rt_enter_critical();
+    rt_thread_startup(&bench_threads[0]);
+    rt_thread_startup(&bench_threads[1]);
+    rt_exit_critical();
+    rt_sem_take(&bench_done, RT_WAITING_FOREVER);
+    thread_switch = (bench_end - bench_start) / (2 * CORO_BENCH_ROUNDS);
+
+    rt_sem_detach(&bench_done);
+
+    rt_kprintf("           bytes/task cycles/switch\n");
+    rt_kprintf("coroutine  %10d %13u\n", sizeof(struct coro_bench_task), coro_switch);
+    rt_kprintf("thread     %10d %13u\n", sizeof(struct rt_thread) + CORO_BENCH_STACK_SIZE, thread_switch);
+
+    tcoro = rt_thread_find("tcoro");
+    if (tcoro != RT_NULL)
+    {
+        rt_kprintf("shared runtime thread: %d bytes, stack used %d of %d\n",
+                   sizeof(struct rt_thread) + tcoro->stack_size,
+                   coro_bench_stack_used(tcoro), tcoro->stack_size);
+    }
+}
+MSH_CMD_EXPORT(coro_bench, compare coroutine and thread memory and switch cost);
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+/*
+ * Cycles per path lookup, stat and open/close pair of a file on a mounted
+ * file system. Build with and without DFS_USING_PATH_CACHE to compare, the
+ * lookup column is the part the cache saves on each call.
+ */
+
+#include <rtthread.h>
+#include <probe.h>
+
+#ifdef RT_USING_DFS
+
+#include <dfs_posix.h>
+#include <dfs_fs.h>
+
+#define DFS_BENCH_ROUNDS        100
+#define DFS_BENCH_PATH          "/dfs_bench.txt"
+
+static void dfs_bench(int argc, char *argv[])
+{
+    const char *path = (argc > 1) ? argv[1] : DFS_BENCH_PATH;
+    rt_uint32_t start, lookup, stat_cycles, open_close;
+    struct stat buf;
+    char *fullpath;
+    int fd, i;
+
+    fd = open(path, O_WRONLY | O_CREAT, 0);
+    if (fd < 0)
+    {
+        rt_kprintf("dfs_bench: can not create %s\n", path);
+        return;
+    }
+    close(fd);
+
+    start = probe_cycles();
+    for (i = 0; i < DFS_BENCH_ROUNDS; i++)
+    {
+        dfs_path_lookup(path, &fullpath);
+        rt_free(fullpath);
+    }
+    lookup = (probe_cycles() - start) / DFS_BENCH_ROUNDS;
+
+    start = probe_cycles();
+    for (i = 0; i < DFS_BENCH_ROUNDS; i++)
+        stat(path, &buf);
+    stat_cycles = (probe_cycles() - start) / DFS_BENCH_ROUNDS;
+
+    start = probe_cycles();
+    for (i = 0; i < DFS_BENCH_ROUNDS; i++)
+    {
+        fd = open(path, O_RDONLY, 0);
+        close(fd);
+    }
+    open_close = (probe_cycles() - start) / DFS_BENCH_ROUNDS;
+
+#ifdef DFS_USING_PATH_CACHE
+    rt_kprintf("path cache of %d entries\n", DFS_PATH_CACHE_NUM);
+#else
+    rt_kprintf("no path cache\n");
+#endif
+    rt_kprintf("      lookup        stat  open+close  (cycles)\n");
+    rt_kprintf("%12u%12u%12u\n", lookup, stat_cycles, open_close);
+    rt_kprintf("%u open/close pairs per second\n",
+            open_close ? SystemCoreClock / open_close : 0);
+}
+MSH_CMD_EXPORT(dfs_bench, cycles of path lookup stat and open/close: dfs_bench [path]);
+
+#endif /* RT_USING_DFS */
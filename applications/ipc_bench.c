@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rtthread.h>
+#include <probe.h>
+
+#define IPC_BENCH_ROUNDS        1000
+#define IPC_BENCH_STACK_SIZE    512
+
+static struct rt_semaphore bench_sem;
+static struct rt_semaphore bench_ping;
+static struct rt_semaphore bench_pong;
+static struct rt_mutex bench_mutex;
+
+static struct rt_thread bench_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t bench_stack[IPC_BENCH_STACK_SIZE];
+
+/* the peer thread answers every ping and then competes for the mutex */
+static void ipc_bench_peer(void *parameter)
+{
+    int i;
+
+    for (i = 0; i < IPC_BENCH_ROUNDS; i++)
+    {
+        rt_sem_take(&bench_ping, RT_WAITING_FOREVER);
+        rt_sem_release(&bench_pong);
+    }
+
+    for (i = 0; i < IPC_BENCH_ROUNDS; i++)
+    {
+        rt_sem_take(&bench_ping, RT_WAITING_FOREVER);
+        /* suspends on the mutex and raises the priority of the holder */
+        rt_mutex_take(&bench_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&bench_mutex);
+        rt_sem_release(&bench_pong);
+    }
+}
+
+static void ipc_bench(int argc, char *argv[])
+{
+    int i;
+    rt_uint32_t start, cycles;
+
+    rt_sem_init(&bench_sem, "bsem", 1, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&bench_ping, "bping", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&bench_pong, "bpong", 0, RT_IPC_FLAG_FIFO);
+    rt_mutex_init(&bench_mutex, "bmutex", RT_IPC_FLAG_PRIO);
+
+    rt_kprintf("path                 cycles/op\n");
+
+    start = probe_cycles();
+    for (i = 0; i < IPC_BENCH_ROUNDS; i++)
+    {
+        rt_sem_take(&bench_sem, RT_WAITING_FOREVER);
+        rt_sem_release(&bench_sem);
+    }
+    cycles = probe_cycles() - start;
+    rt_kprintf("sem uncontended      %9u\n", cycles / IPC_BENCH_ROUNDS / 2);
+
+    start = probe_cycles();
+    for (i = 0; i < IPC_BENCH_ROUNDS; i++)
+    {
+        rt_mutex_take(&bench_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&bench_mutex);
+    }
+    cycles = probe_cycles() - start;
+    rt_kprintf("mutex uncontended    %9u\n", cycles / IPC_BENCH_ROUNDS / 2);
+
+    rt_mutex_take(&bench_mutex, RT_WAITING_FOREVER);
+    start = probe_cycles();
+    for (i = 0; i < IPC_BENCH_ROUNDS; i++)
+    {
+        rt_mutex_take(&bench_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&bench_mutex);
+    }
+    cycles = probe_cycles() - start;
+    rt_mutex_release(&bench_mutex);
+    rt_kprintf("mutex recursive      %9u\n", cycles / IPC_BENCH_ROUNDS / 2);
+
+    /* the contended paths need a higher priority peer to block on the objects */
+    rt_thread_init(&bench_thread, "bpeer", ipc_bench_peer, RT_NULL,
+                   bench_stack, sizeof(bench_stack),
+                   rt_thread_self()->current_priority - 1, 10);
+    rt_thread_startup(&bench_thread);
+
+    /* every round trip suspends and wakes a thread on both semaphores */
+    start = probe_cycles();
+    for (i = 0; i < IPC_BENCH_ROUNDS; i++)
+    {
+        rt_sem_release(&bench_ping);
+        rt_sem_take(&bench_pong, RT_WAITING_FOREVER);
+    }
+    cycles = probe_cycles() - start;
+    rt_kprintf("sem contended        %9u\n", cycles / IPC_BENCH_ROUNDS / 2);
+
+    /* the peer suspends on the held mutex, the release hands it over */
+    start = probe_cycles();
+    for (i = 0; i < IPC_BENCH_ROUNDS; i++)
+    {
+        rt_mutex_take(&bench_mutex, RT_WAITING_FOREVER);
+        rt_sem_release(&bench_ping);
+        rt_mutex_release(&bench_mutex);
+        rt_sem_take(&bench_pong, RT_WAITING_FOREVER);
+    }
+    cycles = probe_cycles() - start;
+    rt_kprintf("mutex contended      %9u\n", cycles / IPC_BENCH_ROUNDS / 4);
+
+    if (bench_mutex.owner != RT_NULL || bench_mutex.value != 1)
+        rt_kprintf("mutex left in a bad state\n");
+
+    /* the peer has run to its end and detached itself */
+    rt_mutex_detach(&bench_mutex);
+    rt_sem_detach(&bench_pong);
+    rt_sem_detach(&bench_ping);
+    rt_sem_detach(&bench_sem);
+}
+MSH_CMD_EXPORT(ipc_bench, measure semaphore and mutex fast and slow paths);
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rtthread.h>
+
+#ifdef RT_USING_UTEST
+#include <utest.h>
+
+/*
+ * Kernel primitive benchmarks, run with "utest_bench <runs> kernel.bench".
+ * Every unit is one timed sample; a peer thread that sees the end of an
+ * operation reports the latency itself with utest_bench_record().
+ */
+
+#define KBENCH_STACK_SIZE       512
+#define KBENCH_BATCH            16
+
+static struct rt_thread kbench_peer;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t kbench_peer_stack[KBENCH_STACK_SIZE];
+
+static struct rt_semaphore kbench_sem;
+static struct rt_semaphore kbench_ack;
+static struct rt_mutex kbench_mutex;
+static struct rt_mailbox kbench_mb;
+static rt_ubase_t kbench_mb_pool[KBENCH_BATCH];
+static struct rt_messagequeue kbench_mq;
+static rt_uint8_t kbench_mq_pool[KBENCH_BATCH * (sizeof(void *) + sizeof(rt_uint32_t))];
+static struct rt_timer kbench_timer;
+
+static volatile rt_uint32_t kbench_t0;
+static volatile rt_bool_t kbench_peer_exit;
+static rt_bool_t kbench_peer_running;
+
+static void kbench_peer_start(void (*entry)(void *parameter), rt_uint8_t priority)
+{
+    kbench_peer_exit = RT_FALSE;
+    rt_thread_init(&kbench_peer, "kbench", entry, RT_NULL, kbench_peer_stack,
+                   sizeof(kbench_peer_stack), priority, 1);
+    rt_thread_startup(&kbench_peer);
+    kbench_peer_running = RT_TRUE;
+}
+
+/* runs the peer once more so it sees the exit flag and returns */
+static void kbench_peer_stop(void)
+{
+    if (!kbench_peer_running)
+        return;
+
+    kbench_peer_exit = RT_TRUE;
+    rt_sem_release(&kbench_sem);
+    rt_sem_take(&kbench_ack, RT_WAITING_FOREVER);
+    rt_thread_detach(&kbench_peer);
+    kbench_peer_running = RT_FALSE;
+
+    /* a peer that never waits on the semaphore leaves it signalled */
+    rt_sem_control(&kbench_sem, RT_IPC_CMD_RESET, 0);
+}
+
+/* context switch: yield to a peer of the same priority and back */
+static void kbench_yield_entry(void *parameter)
+{
+    while (!kbench_peer_exit)
+        rt_thread_yield();
+
+    rt_sem_release(&kbench_ack);
+}
+
+static void kbench_yield(void)
+{
+    rt_thread_yield();
+}
+
+/* semaphore ping-pong with a higher priority peer */
+static void kbench_pingpong_entry(void *parameter)
+{
+    while (1)
+    {
+        rt_sem_take(&kbench_sem, RT_WAITING_FOREVER);
+        if (kbench_peer_exit)
+            break;
+        rt_sem_release(&kbench_ack);
+    }
+
+    rt_sem_release(&kbench_ack);
+}
+
+static void kbench_sem_pingpong(void)
+{
+    rt_sem_release(&kbench_sem);
+    rt_sem_take(&kbench_ack, RT_WAITING_FOREVER);
+}
+
+/* mutex handoff: from the release to the waiting higher priority peer */
+static void kbench_mutex_entry(void *parameter)
+{
+    while (1)
+    {
+        rt_sem_take(&kbench_sem, RT_WAITING_FOREVER);
+        if (kbench_peer_exit)
+            break;
+
+        rt_mutex_take(&kbench_mutex, RT_WAITING_FOREVER);
+        utest_bench_record(utest_bench_clock() - kbench_t0);
+        rt_mutex_release(&kbench_mutex);
+        rt_sem_release(&kbench_ack);
+    }
+
+    rt_sem_release(&kbench_ack);
+}
+
+static void kbench_mutex_handoff(void)
+{
+    rt_mutex_take(&kbench_mutex, RT_WAITING_FOREVER);
+    /* the peer blocks on the mutex */
+    rt_sem_release(&kbench_sem);
+
+    kbench_t0 = utest_bench_clock();
+    rt_mutex_release(&kbench_mutex);
+    rt_sem_take(&kbench_ack, RT_WAITING_FOREVER);
+}
+
+/* mailbox and message queue throughput, per message of a batch */
+static void kbench_mb_batch(void)
+{
+    rt_uint32_t start, index;
+    rt_ubase_t value;
+
+    start = utest_bench_clock();
+    for (index = 0; index < KBENCH_BATCH; index ++)
+        rt_mb_send(&kbench_mb, index);
+    for (index = 0; index < KBENCH_BATCH; index ++)
+        rt_mb_recv(&kbench_mb, &value, 0);
+    utest_bench_record((utest_bench_clock() - start) / KBENCH_BATCH);
+}
+
+static void kbench_mq_batch(void)
+{
+    rt_uint32_t start, index, value;
+
+    start = utest_bench_clock();
+    for (index = 0; index < KBENCH_BATCH; index ++)
+        rt_mq_send(&kbench_mq, &index, sizeof(index));
+    for (index = 0; index < KBENCH_BATCH; index ++)
+        rt_mq_recv(&kbench_mq, &value, sizeof(value), 0);
+    utest_bench_record((utest_bench_clock() - start) / KBENCH_BATCH);
+}
+
+/* interrupt to thread wakeup: the timer callback runs from the tick ISR */
+static void kbench_timer_timeout(void *parameter)
+{
+    kbench_t0 = utest_bench_clock();
+    rt_sem_release(&kbench_sem);
+}
+
+/* timer start and stop, stopped long before it expires */
+static void kbench_timer_start_stop(void)
+{
+    rt_timer_start(&kbench_timer);
+    rt_timer_stop(&kbench_timer);
+}
+
+static void kbench_isr_wakeup(void)
+{
+    rt_timer_start(&kbench_timer);
+    rt_sem_take(&kbench_sem, RT_WAITING_FOREVER);
+    utest_bench_record(utest_bench_clock() - kbench_t0);
+}
+
+static void kbench_testcase(void)
+{
+    rt_uint8_t priority = rt_thread_self()->current_priority;
+    rt_tick_t timeout;
+
+    kbench_peer_start(kbench_yield_entry, priority);
+    UTEST_BENCH_RUN(kbench_yield);
+    kbench_peer_stop();
+
+    kbench_peer_start(kbench_pingpong_entry, priority - 1);
+    UTEST_BENCH_RUN(kbench_sem_pingpong);
+    kbench_peer_stop();
+
+    kbench_peer_start(kbench_mutex_entry, priority - 1);
+    UTEST_BENCH_RUN(kbench_mutex_handoff);
+    kbench_peer_stop();
+
+    UTEST_BENCH_RUN(kbench_mb_batch);
+    UTEST_BENCH_RUN(kbench_mq_batch);
+
+    timeout = RT_TICK_PER_SECOND;
+    rt_timer_control(&kbench_timer, RT_TIMER_CTRL_SET_TIME, &timeout);
+    UTEST_BENCH_RUN(kbench_timer_start_stop);
+
+    timeout = 1;
+    rt_timer_control(&kbench_timer, RT_TIMER_CTRL_SET_TIME, &timeout);
+    UTEST_BENCH_RUN(kbench_isr_wakeup);
+}
+
+static rt_err_t kbench_init(void)
+{
+    rt_sem_init(&kbench_sem, "kbsem", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&kbench_ack, "kback", 0, RT_IPC_FLAG_FIFO);
+    rt_mutex_init(&kbench_mutex, "kbmtx", RT_IPC_FLAG_FIFO);
+    rt_mb_init(&kbench_mb, "kbmb", kbench_mb_pool, KBENCH_BATCH, RT_IPC_FLAG_FIFO);
+    rt_mq_init(&kbench_mq, "kbmq", kbench_mq_pool, sizeof(rt_uint32_t),
+               sizeof(kbench_mq_pool), RT_IPC_FLAG_FIFO);
+    rt_timer_init(&kbench_timer, "kbench", kbench_timer_timeout, RT_NULL, 1,
+                  RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+
+    return RT_EOK;
+}
+
+static rt_err_t kbench_cleanup(void)
+{
+    /* a failed benchmark returns early with its peer still running */
+    kbench_peer_stop();
+    rt_timer_stop(&kbench_timer);
+    rt_timer_detach(&kbench_timer);
+    rt_mq_detach(&kbench_mq);
+    rt_mb_detach(&kbench_mb);
+    rt_mutex_detach(&kbench_mutex);
+    rt_sem_detach(&kbench_ack);
+    rt_sem_detach(&kbench_sem);
+
+    return RT_EOK;
+}
+UTEST_TC_EXPORT(kbench_testcase, "kernel.bench", kbench_init, kbench_cleanup, 60);
+
+#endif /* RT_USING_UTEST */
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#ifdef RT_USING_UTEST
+#include <utest.h>
+
+/*
+ * Lock-free ring buffer tests, run with "utest_run drivers.lfring". The
+ * stress units race a 1 kHz hard timer, which writes a burst of records from
+ * the tick interrupt, against the consuming thread and check that no record
+ * is lost out of order.
+ */
+
+#define LFRING_TC_SIZE          64
+#define LFRING_STRESS_SIZE      1024
+#define LFRING_STRESS_TICKS     (RT_TICK_PER_SECOND)
+#define LFRING_STRESS_BURST     8
+
+static rt_uint8_t lfring_pool[LFRING_STRESS_SIZE];
+static struct rt_lfring lfring_tc;
+
+static struct rt_timer lfring_timer;
+static volatile rt_uint32_t lfring_isr_seq;
+static volatile rt_uint32_t lfring_isr_drop;
+static volatile rt_bool_t lfring_mp_mode;
+
+/* one record of the stress test: producer id and its sequence number */
+struct lfring_record
+{
+    rt_uint32_t producer;
+    rt_uint32_t seq;
+};
+
+static void lfring_fill(rt_uint8_t *buf, rt_uint32_t length, rt_uint8_t seed)
+{
+    while (length--)
+        *buf++ = seed++;
+}
+
+static void lfring_spsc_basic(void)
+{
+    rt_uint8_t in[LFRING_TC_SIZE], out[LFRING_TC_SIZE];
+
+    rt_lfring_init(&lfring_tc, lfring_pool, LFRING_TC_SIZE);
+    uassert_int_equal(rt_lfring_data_len(&lfring_tc), 0);
+    uassert_int_equal(rt_lfring_get(&lfring_tc, out, sizeof(out)), 0);
+
+    lfring_fill(in, 48, 0);
+    uassert_int_equal(rt_lfring_put(&lfring_tc, in, 48), 48);
+    uassert_int_equal(rt_lfring_get(&lfring_tc, out, 32), 32);
+    uassert_buf_equal(out, in, 32);
+
+    /* this one wraps at the end of the buffer */
+    lfring_fill(in, 40, 48);
+    uassert_int_equal(rt_lfring_put(&lfring_tc, in, 40), 40);
+    uassert_int_equal(rt_lfring_data_len(&lfring_tc), 56);
+
+    /* a full ring takes what fits */
+    uassert_int_equal(rt_lfring_put(&lfring_tc, in, 40), 8);
+    uassert_int_equal(rt_lfring_space_len(&lfring_tc), 0);
+
+    lfring_fill(in, 56, 32);
+    uassert_int_equal(rt_lfring_get(&lfring_tc, out, 56), 56);
+    uassert_buf_equal(out, in, 56);
+}
+
+static void lfring_mp_basic(void)
+{
+    rt_uint8_t in[LFRING_TC_SIZE], out[LFRING_TC_SIZE];
+    int index;
+
+    rt_lfring_init(&lfring_tc, lfring_pool, LFRING_TC_SIZE);
+    uassert_int_equal(rt_lfring_mp_get(&lfring_tc, out, sizeof(out)), 0);
+    uassert_int_equal(rt_lfring_mp_put(&lfring_tc, in, 2 * LFRING_TC_SIZE), 0);
+
+    /* 10 bytes take 16 with the header, so four of them fill the ring */
+    for (index = 0; index < 4; index++)
+    {
+        lfring_fill(in, 10, index * 10);
+        uassert_int_equal(rt_lfring_mp_put(&lfring_tc, in, 10), 10);
+    }
+    uassert_int_equal(rt_lfring_mp_put(&lfring_tc, in, 10), 0);
+
+    for (index = 0; index < 4; index++)
+    {
+        lfring_fill(in, 10, index * 10);
+        uassert_int_equal(rt_lfring_mp_get(&lfring_tc, out, sizeof(out)), 10);
+        uassert_buf_equal(out, in, 10);
+    }
+
+    /* records of 24 bytes at 0 and 24, the third one has to pad the end */
+    lfring_fill(in, 20, 100);
+    uassert_int_equal(rt_lfring_mp_put(&lfring_tc, in, 20), 20);
+    uassert_int_equal(rt_lfring_mp_put(&lfring_tc, in, 20), 20);
+    uassert_int_equal(rt_lfring_mp_put(&lfring_tc, in, 20), 0);
+
+    /* truncated to the length asked for */
+    uassert_int_equal(rt_lfring_mp_get(&lfring_tc, out, 4), 4);
+    uassert_buf_equal(out, in, 4);
+
+    lfring_fill(in, 20, 200);
+    uassert_int_equal(rt_lfring_mp_put(&lfring_tc, in, 20), 20);
+    uassert_int_equal(rt_lfring_mp_get(&lfring_tc, out, sizeof(out)), 20);
+    uassert_int_equal(rt_lfring_mp_get(&lfring_tc, out, sizeof(out)), 20);
+    uassert_buf_equal(out, in, 20);
+    uassert_int_equal(rt_lfring_mp_get(&lfring_tc, out, sizeof(out)), 0);
+}
+
+static void lfring_stress_isr(void *parameter)
+{
+    int i;
+    struct lfring_record rec;
+
+    /* a burst of writes from interrupt context on every tick */
+    for (i = 0; i < LFRING_STRESS_BURST; i++)
+    {
+        rec.producer = 0;
+        rec.seq = lfring_isr_seq;
+
+        if (lfring_mp_mode)
+        {
+            if (rt_lfring_mp_put(&lfring_tc, (rt_uint8_t *)&rec, sizeof(rec)) == 0)
+            {
+                lfring_isr_drop++;
+                continue;
+            }
+        }
+        else if (rt_lfring_space_len(&lfring_tc) < sizeof(rec.seq))
+        {
+            lfring_isr_drop++;
+            continue;
+        }
+        else
+        {
+            rt_lfring_put(&lfring_tc, (rt_uint8_t *)&rec.seq, sizeof(rec.seq));
+        }
+        lfring_isr_seq++;
+    }
+}
+
+static rt_uint32_t lfring_stress(rt_bool_t mp_mode)
+{
+    rt_tick_t end;
+    rt_uint32_t seq;
+    rt_uint32_t expect[2] = {0, 0};
+    rt_uint32_t thread_seq = 0;
+    rt_uint32_t received = 0;
+    struct lfring_record rec;
+    rt_bool_t in_order = RT_TRUE;
+
+    rt_lfring_init(&lfring_tc, lfring_pool, LFRING_STRESS_SIZE);
+    lfring_isr_seq = lfring_isr_drop = 0;
+    lfring_mp_mode = mp_mode;
+    rt_timer_start(&lfring_timer);
+
+    end = rt_tick_get() + LFRING_STRESS_TICKS;
+    while (in_order && (rt_int32_t)(rt_tick_get() - end) < 0)
+    {
+        if (mp_mode)
+        {
+            /* the consuming thread also produces, racing the ISR */
+            rec.producer = 1;
+            rec.seq = thread_seq;
+            if (rt_lfring_mp_put(&lfring_tc, (rt_uint8_t *)&rec, sizeof(rec)))
+                thread_seq++;
+
+            while (rt_lfring_mp_get(&lfring_tc, (rt_uint8_t *)&rec, sizeof(rec)) == sizeof(rec))
+            {
+                if (rec.producer > 1 || rec.seq != expect[rec.producer])
+                {
+                    in_order = RT_FALSE;
+                    break;
+                }
+                expect[rec.producer]++;
+                received++;
+            }
+        }
+        else
+        {
+            while (rt_lfring_get(&lfring_tc, (rt_uint8_t *)&seq, sizeof(seq)) == sizeof(seq))
+            {
+                if (seq != expect[0])
+                {
+                    in_order = RT_FALSE;
+                    break;
+                }
+                expect[0]++;
+                received++;
+            }
+        }
+    }
+    rt_timer_stop(&lfring_timer);
+
+    LOG_I("%s stress: %u records, %u isr drops", mp_mode ? "mp" : "spsc", received, lfring_isr_drop);
+    uassert_true(in_order);
+
+    return received;
+}
+
+static void lfring_spsc_stress(void)
+{
+    uassert_true(lfring_stress(RT_FALSE) > 0);
+}
+
+static void lfring_mp_stress(void)
+{
+    uassert_true(lfring_stress(RT_TRUE) > 0);
+}
+
+static rt_err_t lfring_tc_init(void)
+{
+    rt_timer_init(&lfring_timer, "lfring", lfring_stress_isr, RT_NULL, 1,
+                  RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+
+    return RT_EOK;
+}
+
+static rt_err_t lfring_tc_cleanup(void)
+{
+    rt_timer_stop(&lfring_timer);
+    rt_timer_detach(&lfring_timer);
+
+    return RT_EOK;
+}
+
+static void lfring_testcase(void)
+{
+    UTEST_UNIT_RUN(lfring_spsc_basic);
+    UTEST_UNIT_RUN(lfring_mp_basic);
+    UTEST_UNIT_RUN(lfring_spsc_stress);
+    UTEST_UNIT_RUN(lfring_mp_stress);
+}
+UTEST_TC_EXPORT(lfring_testcase, "drivers.lfring", lfring_tc_init, lfring_tc_cleanup, 10);
+
+#endif /* RT_USING_UTEST */
@@ -6,34 +6,45 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-06     SummerGift   first version
+ * 2026-10-19     yqiu         blink LED0 from a coroutine and let main exit
  */
 
 #include <rtthread.h>
 #include <rtdevice.h>
 #include <board.h>
+#include <coro.h>
 /* defined the LED0 pin: PE7 */
 #define LED0_PIN    GET_PIN(E, 7)
 
 extern void car_init(void *parameter);
 
-int main(void)
-{
-    int count = 1;
+static struct coro led_coro;
 
-    car_init((0));
-    
-    /* set LED0 pin mode to output */
-    rt_pin_mode(LED0_PIN, PIN_MODE_OUTPUT);
+static int led_blink(struct coro *co)
+{
+    CORO_BEGIN(co);
 
-    while (count++)
+    while (1)
     {
         rt_pin_write(LED0_PIN, PIN_HIGH);
-        rt_thread_mdelay(500);
+        CORO_MDELAY(co, 500);
         rt_pin_write(LED0_PIN, PIN_LOW);
-        rt_thread_mdelay(500);
+        CORO_MDELAY(co, 500);
     }
 
-    return RT_EOK;
+    CORO_END(co);
 }
 
+int main(void)
+{
+    car_init((0));
+    
+    /* set LED0 pin mode to output */
+    rt_pin_mode(LED0_PIN, PIN_MODE_OUTPUT);
+
+    /* the blinker needs no stack of its own, so the main thread can exit */
+    coro_init(&led_coro, "led", led_blink, RT_NULL);
+    coro_start(&led_coro);
 
+    return RT_EOK;
+}
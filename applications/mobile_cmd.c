@@ -2,6 +2,7 @@
 #include <rtdevice.h>
 #include <board.h>
 #include <chassis.h>
+#include <recorder.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -56,6 +57,7 @@ static void mobile_robot(int argc, char *argv[])
     target_vel.linear_y = linear_y;   // m/s
     target_vel.angular_z = angular_z; // rad/s
 
+    recorder_command(target_vel.linear_x, target_vel.linear_y, target_vel.angular_z);
     chassis_set_velocity(chas, target_vel);
     if (duration > 0)
     {
@@ -65,6 +67,7 @@ static void mobile_robot(int argc, char *argv[])
         target_vel.linear_y = 0;  // m/s
         target_vel.angular_z = 0; // rad/s
 
+        recorder_command(target_vel.linear_x, target_vel.linear_y, target_vel.angular_z);
         chassis_set_velocity(chas, target_vel);
     }
 }
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rtthread.h>
+#include <probe.h>
+
+#define MP_BENCH_BLOCKS         32
+#define MP_BENCH_BLOCK_SIZE     32
+#define MP_BENCH_ROUNDS         1000
+#define MP_BENCH_BURST          12              /* more than a magazine holds */
+
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t mp_bench_buf[MP_BENCH_BLOCKS * (MP_BENCH_BLOCK_SIZE + sizeof(rt_uint8_t *))];
+static struct rt_mempool mp_bench_pool;
+static struct rt_mp_magazine mp_bench_mag;
+static void *mp_bench_blocks[MP_BENCH_BURST];
+
+/* cycles per alloc/free pair, single block and in bursts */
+static void mp_bench_pool_run(rt_uint32_t *single, rt_uint32_t *burst)
+{
+    int i, j;
+    rt_uint32_t start;
+
+    start = probe_cycles();
+    for (i = 0; i < MP_BENCH_ROUNDS; i++)
+        rt_mp_free(rt_mp_alloc(&mp_bench_pool, 0));
+    *single = (probe_cycles() - start) / MP_BENCH_ROUNDS;
+
+    start = probe_cycles();
+    for (i = 0; i < MP_BENCH_ROUNDS; i++)
+    {
+        for (j = 0; j < MP_BENCH_BURST; j++)
+            mp_bench_blocks[j] = rt_mp_alloc(&mp_bench_pool, 0);
+        for (j = 0; j < MP_BENCH_BURST; j++)
+            rt_mp_free(mp_bench_blocks[j]);
+    }
+    *burst = (probe_cycles() - start) / (MP_BENCH_ROUNDS * MP_BENCH_BURST);
+}
+
+static void mp_bench_magazine_run(rt_uint32_t *single, rt_uint32_t *burst)
+{
+    int i, j;
+    rt_uint32_t start;
+
+    start = probe_cycles();
+    for (i = 0; i < MP_BENCH_ROUNDS; i++)
+        rt_mp_magazine_free(&mp_bench_mag, rt_mp_magazine_alloc(&mp_bench_mag, 0));
+    *single = (probe_cycles() - start) / MP_BENCH_ROUNDS;
+
+    start = probe_cycles();
+    for (i = 0; i < MP_BENCH_ROUNDS; i++)
+    {
+        for (j = 0; j < MP_BENCH_BURST; j++)
+            mp_bench_blocks[j] = rt_mp_magazine_alloc(&mp_bench_mag, 0);
+        for (j = 0; j < MP_BENCH_BURST; j++)
+            rt_mp_magazine_free(&mp_bench_mag, mp_bench_blocks[j]);
+    }
+    *burst = (probe_cycles() - start) / (MP_BENCH_ROUNDS * MP_BENCH_BURST);
+}
+
+static void mp_bench_sizeclass(void)
+{
+    static const rt_size_t sizes[]  = {16, 32, 64};
+    static const rt_size_t counts[] = {2, 2, 2};
+    struct rt_mp_sizeclass sc;
+    void *blocks[4];
+    int i;
+
+    if (rt_mp_sizeclass_create(&sc, "mpsc", sizes, counts, 3) != RT_EOK)
+    {
+        rt_kprintf("size class: no memory\n");
+        return;
+    }
+
+    /* four 12 byte objects: two from the 16 byte class, then from the 32 byte class */
+    rt_kprintf("size class: 12 bytes from");
+    for (i = 0; i < 4; i++)
+    {
+        blocks[i] = rt_mp_sizeclass_alloc(&sc, 12, 0);
+        rt_kprintf(" %d", blocks[i] ? ((rt_mp_t)*((rt_uint8_t **)blocks[i] - 1))->block_size : 0);
+    }
+    rt_kprintf("\n");
+
+    for (i = 0; i < 4; i++)
+    {
+        if (blocks[i])
+            rt_mp_free(blocks[i]);
+    }
+    rt_mp_sizeclass_delete(&sc);
+}
+
+static void mp_bench(int argc, char *argv[])
+{
+    rt_uint32_t pool_single, pool_burst, mag_single, mag_burst;
+
+    rt_mp_init(&mp_bench_pool, "mpbench", mp_bench_buf, sizeof(mp_bench_buf), MP_BENCH_BLOCK_SIZE);
+    rt_mp_magazine_init(&mp_bench_mag, &mp_bench_pool, rt_thread_self());
+
+    mp_bench_pool_run(&pool_single, &pool_burst);
+    mp_bench_magazine_run(&mag_single, &mag_burst);
+
+    rt_kprintf("            cycles/pair burst cycles/pair\n");
+    rt_kprintf("rt_mp       %11u %17u\n", pool_single, pool_burst);
+    rt_kprintf("magazine    %11u %17u\n", mag_single, mag_burst);
+    rt_kprintf("magazine refills %u, drains %u\n", mp_bench_mag.refill_count, mp_bench_mag.drain_count);
+
+    rt_mp_magazine_flush(&mp_bench_mag);
+    rt_mp_detach(&mp_bench_pool);
+
+    mp_bench_sizeclass();
+}
+MSH_CMD_EXPORT(mp_bench, compare memory pool and magazine alloc/free cost);
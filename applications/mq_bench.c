@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rtthread.h>
+#include <probe.h>
+
+#define MQ_BENCH_MSGS       8
+#define MQ_BENCH_ROUNDS     1000
+#define MQ_BENCH_SIZE_MAX   512
+
+static rt_uint8_t mq_bench_buf[MQ_BENCH_SIZE_MAX];
+
+static rt_uint32_t mq_bench_copy(rt_mq_t mq, rt_size_t size)
+{
+    int i;
+    rt_uint32_t start;
+
+    start = probe_cycles();
+    for (i = 0; i < MQ_BENCH_ROUNDS; i++)
+    {
+        rt_memset(mq_bench_buf, i, size);
+        rt_mq_send(mq, mq_bench_buf, size);
+        rt_mq_recv(mq, mq_bench_buf, size, RT_WAITING_FOREVER);
+    }
+
+    return probe_cycles() - start;
+}
+
+static rt_uint32_t mq_bench_loan(rt_mq_t mq, rt_size_t size)
+{
+    int i;
+    void *msg;
+    rt_uint32_t start;
+
+    start = probe_cycles();
+    for (i = 0; i < MQ_BENCH_ROUNDS; i++)
+    {
+        msg = rt_mq_loan(mq);
+        rt_memset(msg, i, size);
+        rt_mq_commit(mq, msg);
+        rt_mq_recv_loan(mq, &msg, RT_WAITING_FOREVER);
+        rt_mq_release(mq, msg);
+    }
+
+    return probe_cycles() - start;
+}
+
+static void mq_bench(int argc, char *argv[])
+{
+    rt_mq_t mq;
+    rt_size_t size;
+    rt_uint32_t copy, loan;
+
+    rt_kprintf("size  copy(cyc/msg) loan(cyc/msg)\n");
+    for (size = 16; size <= MQ_BENCH_SIZE_MAX; size <<= 1)
+    {
+        mq = rt_mq_create("mqbench", size, MQ_BENCH_MSGS, RT_IPC_FLAG_FIFO);
+        if (mq == RT_NULL)
+        {
+            rt_kprintf("no memory for %d byte messages\n", size);
+            return;
+        }
+
+        copy = mq_bench_copy(mq, size) / MQ_BENCH_ROUNDS;
+        loan = mq_bench_loan(mq, size) / MQ_BENCH_ROUNDS;
+        rt_kprintf("%4d  %13u %13u\n", size, copy, loan);
+
+        rt_mq_delete(mq);
+    }
+}
+MSH_CMD_EXPORT(mq_bench, compare copy and loan message queue throughput);
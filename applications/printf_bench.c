@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+/*
+ * Cycles per call of rt_snprintf with RT_PRINTF_FLOAT and, with RT_USING_LIBC,
+ * of the newlib snprintf on the same formats. The code size is compared on the
+ * map of the two builds, e.g.
+ *
+ *     arm-none-eabi-nm --size-sort -S rtthread.elf | grep -e print_float -e _dtoa_r -e _svfprintf_r
+ */
+
+#include <rtthread.h>
+#include <probe.h>
+
+#ifdef RT_PRINTF_FLOAT
+
+#ifdef RT_USING_LIBC
+#include <stdio.h>
+#endif
+
+#define PRINTF_BENCH_ROUNDS     100
+
+struct printf_bench_case
+{
+    const char *format;
+    double value;
+};
+
+static const struct printf_bench_case printf_bench_cases[] =
+{
+    {"%.2f",   3.3046875},          /* a voltage */
+    {"%8.3f", -127.0625},           /* a velocity */
+    {"%f",     0.000123456789},
+    {"%.6f",   123456.789},
+    {"%e",     6.02214076e23},
+    {"%.3e",  -1.602176634e-19},
+    {"%g",     0.1},
+    {"%g",     1234567.0},
+};
+
+static char printf_bench_buf[64];
+
+static void printf_bench(int argc, char *argv[])
+{
+    const struct printf_bench_case *c;
+    rt_uint32_t start, rt_cycles;
+    int i, j;
+
+    rt_kprintf("format  rt cycles    rt output");
+#ifdef RT_USING_LIBC
+    rt_kprintf("        libc cycles  libc output");
+#endif
+    rt_kprintf("\n");
+
+    for (i = 0; i < sizeof(printf_bench_cases) / sizeof(printf_bench_cases[0]); i++)
+    {
+        c = &printf_bench_cases[i];
+
+        start = probe_cycles();
+        for (j = 0; j < PRINTF_BENCH_ROUNDS; j++)
+            rt_snprintf(printf_bench_buf, sizeof(printf_bench_buf), c->format, c->value);
+        rt_cycles = (probe_cycles() - start) / PRINTF_BENCH_ROUNDS;
+        rt_kprintf("%-7s %9u    %-20s", c->format, rt_cycles, printf_bench_buf);
+
+#ifdef RT_USING_LIBC
+        start = probe_cycles();
+        for (j = 0; j < PRINTF_BENCH_ROUNDS; j++)
+            snprintf(printf_bench_buf, sizeof(printf_bench_buf), c->format, c->value);
+        rt_kprintf(" %11u  %s", (probe_cycles() - start) / PRINTF_BENCH_ROUNDS, printf_bench_buf);
+#endif
+        rt_kprintf("\n");
+    }
+}
+MSH_CMD_EXPORT(printf_bench, compare rt_snprintf and libc snprintf float formatting cost);
+
+#endif /* RT_PRINTF_FLOAT */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <probe.h>
+
+/* registered probes always have a non-null next, the list ends on this sentinel */
+static struct probe probe_tail = PROBE_INIT("");
+static probe_t probe_list = &probe_tail;
+
+void probe_register(probe_t p)
+{
+    rt_base_t level;
+
+    RT_ASSERT(p != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    if (p->next == RT_NULL)
+    {
+        p->next = probe_list;
+        probe_list = p;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+void probe_reset(probe_t p)
+{
+    rt_base_t level;
+
+    RT_ASSERT(p != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    p->count = 0;
+    p->min = 0xFFFFFFFF;
+    p->max = 0;
+    p->sum = 0;
+    rt_memset(p->hist, 0, sizeof(p->hist));
+    rt_hw_interrupt_enable(level);
+}
+
+static int probe_init(void)
+{
+    /* the counter keeps running, the boot time is counted from it */
+    rt_hw_cycle_counter_enable();
+
+    return 0;
+}
+INIT_BOARD_EXPORT(probe_init);
+
+static void probe_dump(probe_t p)
+{
+    int i;
+    rt_uint32_t mean;
+
+    if (p->count == 0)
+    {
+        rt_kprintf("%-12s no samples\n", p->name);
+        return;
+    }
+
+    mean = (rt_uint32_t)(p->sum / p->count);
+    rt_kprintf("%-12s count %u min %u max %u mean %u (cycles, %u MHz)\n",
+               p->name, p->count, p->min, p->max, mean, SystemCoreClock / 1000000);
+
+    for (i = 0; i < PROBE_BUCKETS; i++)
+    {
+        if (p->hist[i] == 0)
+            continue;
+
+        /* samples of 0 cycles are counted in bucket 0 with those of 1 */
+        rt_kprintf("    [%10u, %10u) %u\n", (i > 0) ? (1UL << i) : 0,
+                   (i < 31) ? (1UL << (i + 1)) : 0xFFFFFFFF, p->hist[i]);
+    }
+}
+
+static void probe(int argc, char *argv[])
+{
+    probe_t p;
+    rt_bool_t reset = RT_FALSE;
+
+    if (argc > 1 && !rt_strcmp(argv[1], "-r"))
+    {
+        reset = RT_TRUE;
+    }
+
+    for (p = probe_list; p != &probe_tail; p = p->next)
+    {
+        probe_dump(p);
+        if (reset)
+            probe_reset(p);
+    }
+}
+MSH_CMD_EXPORT(probe, dump cycle probe histograms [-r reset]);
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#ifndef __PROBE_H__
+#define __PROBE_H__
+
+#include <rtthread.h>
+#include <board.h>
+
+/*
+ * Cycle probes
+ *
+ * A probe measures the DWT cycle count between a begin and an end marker and
+ * keeps min, max, sum and a log2 histogram: bucket n counts the samples in
+ * [2^n, 2^(n+1)) cycles, bucket 0 also those of 0 cycles. Recording a sample
+ * is a handful of instructions and takes no lock, so a probe must only be
+ * ended from one context at a time.
+ *
+ *     static struct probe pid_probe = PROBE_INIT("pid");
+ *
+ *     PROBE_BEGIN(pid_probe);
+ *     ...
+ *     PROBE_END(pid_probe);
+ */
+
+#define PROBE_BUCKETS               32
+
+struct probe
+{
+    const char *name;
+    struct probe *next;
+
+    rt_uint32_t count;
+    rt_uint32_t min;
+    rt_uint32_t max;
+    rt_uint64_t sum;
+    rt_uint32_t hist[PROBE_BUCKETS];
+};
+typedef struct probe *probe_t;
+
+#define PROBE_INIT(probe_name)      { probe_name, RT_NULL, 0, 0xFFFFFFFF, 0, 0, {0} }
+
+#define PROBE_BEGIN(p)              rt_uint32_t __probe_start_##p = probe_cycles()
+#define PROBE_END(p)                probe_record(&(p), probe_cycles() - __probe_start_##p)
+
+void probe_register(probe_t p);
+void probe_reset(probe_t p);
+
+rt_inline rt_uint32_t probe_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+rt_inline void probe_record(probe_t p, rt_uint32_t cycles)
+{
+    if (p->count == 0 && p->next == RT_NULL)
+    {
+        probe_register(p);
+    }
+
+    p->count++;
+    p->sum += cycles;
+    if (cycles < p->min) p->min = cycles;
+    if (cycles > p->max) p->max = cycles;
+    p->hist[31 - __CLZ(cycles | 1)]++;
+}
+
+#endif
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <board.h>
+#include <rate_group.h>
+
+#define DBG_SECTION_NAME  "rgrp"
+#define DBG_LEVEL         DBG_LOG
+#include <rtdbg.h>
+
+/* the control loops run from SRAM2 */
+static struct rate_group groups[RATE_GROUP_MAX] BSP_SECTION_SRAM2;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t group_stacks[RATE_GROUP_MAX][RATE_GROUP_STACK_SIZE] BSP_SECTION_SRAM2;
+static rt_uint8_t group_num = 0;
+
+static struct rt_timer rate_timer;
+static rt_uint32_t rate_tick = 0;
+static rt_bool_t rate_started = RT_FALSE;
+#ifdef RT_USING_INIT_PROFILE
+static volatile rt_bool_t rate_first_cycle = RT_TRUE;
+#endif
+
+void rate_stage_init(rate_stage_t stage, const char *name, void (*entry)(void *parameter), void *parameter)
+{
+    RT_ASSERT(stage != RT_NULL);
+    RT_ASSERT(entry != RT_NULL);
+
+    rt_slist_init(&(stage->list));
+    stage->name      = name;
+    stage->entry     = entry;
+    stage->parameter = parameter;
+}
+
+rate_group_t rate_group_find(rt_uint32_t rate_hz)
+{
+    rt_uint8_t i;
+
+    for (i = 0; i < group_num; i++)
+    {
+        if (groups[i].rate_hz == rate_hz)
+            return &groups[i];
+    }
+
+    return RT_NULL;
+}
+
+rt_err_t rate_stage_register(rate_stage_t stage, rt_uint32_t rate_hz, rt_uint8_t priority)
+{
+    rate_group_t grp;
+
+    RT_ASSERT(stage != RT_NULL);
+
+    if (rate_started)
+    {
+        LOG_E("Stage %s registered after executor start", stage->name);
+        return -RT_EBUSY;
+    }
+
+    /* every group must be released on a whole number of base ticks */
+    if (rate_hz == 0 || rate_hz > RT_TICK_PER_SECOND || (RT_TICK_PER_SECOND % rate_hz) != 0)
+    {
+        LOG_E("Stage %s rate %d Hz is not a divisor of %d Hz", stage->name, rate_hz, RT_TICK_PER_SECOND);
+        return -RT_EINVAL;
+    }
+
+    grp = rate_group_find(rate_hz);
+    if (grp == RT_NULL)
+    {
+        if (group_num >= RATE_GROUP_MAX)
+        {
+            LOG_E("No free rate group for %s", stage->name);
+            return -RT_EFULL;
+        }
+
+        grp = &groups[group_num++];
+        rt_memset(grp, 0, sizeof(struct rate_group));
+        rt_snprintf(grp->name, RT_NAME_MAX, "rg%d", rate_hz);
+        grp->rate_hz  = rate_hz;
+        grp->divider  = RT_TICK_PER_SECOND / rate_hz;
+        grp->priority = priority;
+        rt_slist_init(&(grp->stages));
+        grp->probe.name = grp->name;
+        probe_reset(&(grp->probe));
+    }
+    else if (priority < grp->priority)
+    {
+        /* a group runs at the most urgent priority of its stages */
+        grp->priority = priority;
+    }
+
+    rt_slist_append(&(grp->stages), &(stage->list));
+
+    return RT_EOK;
+}
+
+static void rate_group_entry(void *parameter)
+{
+    rt_slist_t *node;
+    rt_uint32_t start;
+    rate_group_t grp = (rate_group_t)parameter;
+
+    while (1)
+    {
+        rt_sem_take(&(grp->sem), RT_WAITING_FOREVER);
+
+        start = probe_cycles();
+        rt_slist_for_each(node, &(grp->stages))
+        {
+            rate_stage_t stage = rt_slist_entry(node, struct rate_stage, list);
+            stage->entry(stage->parameter);
+        }
+        probe_record(&(grp->probe), probe_cycles() - start);
+
+#ifdef RT_USING_INIT_PROFILE
+        if (rate_first_cycle)
+        {
+            rate_first_cycle = RT_FALSE;
+            rt_components_boot_mark("first control cycle");
+        }
+#endif
+
+        grp->busy = 0;
+    }
+}
+
+static void rate_timer_timeout(void *parameter)
+{
+    rt_uint8_t i;
+
+    /* all groups count the same base tick, which keeps them phase-aligned */
+    for (i = 0; i < group_num; i++)
+    {
+        rate_group_t grp = &groups[i];
+
+        if (rate_tick % grp->divider)
+            continue;
+
+        if (grp->busy)
+        {
+            grp->overruns++;
+            continue;
+        }
+
+        grp->busy = 1;
+        grp->releases++;
+        rt_sem_release(&(grp->sem));
+    }
+
+    rate_tick++;
+}
+
+rt_err_t rate_group_start(void)
+{
+    rt_uint8_t i;
+
+    if (rate_started)
+        return -RT_EBUSY;
+
+    for (i = 0; i < group_num; i++)
+    {
+        rate_group_t grp = &groups[i];
+
+        rt_sem_init(&(grp->sem), grp->name, 0, RT_IPC_FLAG_FIFO);
+        rt_thread_init(&(grp->thread), grp->name,
+                       rate_group_entry, grp,
+                       group_stacks[i], RATE_GROUP_STACK_SIZE,
+                       grp->priority, RATE_GROUP_TIMESLICE);
+        rt_thread_startup(&(grp->thread));
+    }
+
+    rate_tick = 0;
+    rt_timer_init(&rate_timer, "rgrp", rate_timer_timeout, RT_NULL,
+                  1, RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    rt_timer_start(&rate_timer);
+    rate_started = RT_TRUE;
+
+    return RT_EOK;
+}
+
+rt_err_t rate_group_stop(void)
+{
+    rt_uint8_t i;
+
+    if (!rate_started)
+        return -RT_ERROR;
+
+    rt_timer_stop(&rate_timer);
+    rt_timer_detach(&rate_timer);
+
+    for (i = 0; i < group_num; i++)
+    {
+        rate_group_t grp = &groups[i];
+
+        rt_thread_detach(&(grp->thread));
+        rt_sem_detach(&(grp->sem));
+        grp->busy = 0;
+    }
+    rate_started = RT_FALSE;
+
+    return RT_EOK;
+}
+
+static void rate_group_dump(int argc, char *argv[])
+{
+    rt_uint8_t i;
+    rt_base_t level;
+
+    rt_kprintf("group    rate(Hz) pri stages releases   overruns   max(cycle)\n");
+    rt_kprintf("-------- -------- --- ------ ---------- ---------- ----------\n");
+    for (i = 0; i < group_num; i++)
+    {
+        rate_group_t grp = &groups[i];
+
+        rt_kprintf("%-8.*s %8d %3d %6d %10d %10d %10u\n", RT_NAME_MAX, grp->name,
+                   grp->rate_hz, grp->priority, rt_slist_len(&(grp->stages)),
+                   grp->releases, grp->overruns, grp->probe.max);
+
+        if (argc > 1 && !rt_strcmp(argv[1], "-r"))
+        {
+            level = rt_hw_interrupt_disable();
+            grp->releases = 0;
+            grp->overruns = 0;
+            rt_hw_interrupt_enable(level);
+            probe_reset(&(grp->probe));
+        }
+    }
+}
+MSH_CMD_EXPORT_ALIAS(rate_group_dump, rate_group, show rate groups and overruns [-r reset]);
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#ifndef __RATE_GROUP_H__
+#define __RATE_GROUP_H__
+
+#include <rtthread.h>
+#include <probe.h>
+
+/*
+ * Rate-group executor
+ *
+ * Every robot stage registers an entry function together with its rate and
+ * priority. Stages sharing a rate are collected into one rate group, which
+ * runs on its own thread. All groups are released from a single periodic
+ * hard timer counting at RT_TICK_PER_SECOND, so the release points of all
+ * groups are phase-aligned: at every 10 ms boundary the 1 kHz, 500 Hz and
+ * 100 Hz groups are released together and run in priority order.
+ *
+ * A release that finds its group still busy with the previous period is
+ * dropped and counted as an overrun.
+ */
+
+#define RATE_GROUP_MAX              4
+#define RATE_GROUP_STACK_SIZE       512
+#define RATE_GROUP_TIMESLICE        5
+
+struct rate_stage
+{
+    rt_slist_t list;
+
+    const char *name;
+    void (*entry)(void *parameter);
+    void *parameter;
+};
+typedef struct rate_stage *rate_stage_t;
+
+struct rate_group
+{
+    char name[RT_NAME_MAX];
+
+    rt_uint32_t rate_hz;
+    rt_uint32_t divider;                        /* base ticks per release */
+    rt_uint8_t priority;
+
+    rt_slist_t stages;
+    struct rt_semaphore sem;
+    struct rt_thread thread;
+
+    volatile rt_uint8_t busy;
+    rt_uint32_t releases;
+    rt_uint32_t overruns;
+    struct probe probe;                         /* run time of all stages */
+};
+typedef struct rate_group *rate_group_t;
+
+void    rate_stage_init(rate_stage_t stage, const char *name, void (*entry)(void *parameter), void *parameter);
+rt_err_t rate_stage_register(rate_stage_t stage, rt_uint32_t rate_hz, rt_uint8_t priority);
+
+rt_err_t rate_group_start(void);
+rt_err_t rate_group_stop(void);
+rate_group_t rate_group_find(rt_uint32_t rate_hz);
+
+#endif
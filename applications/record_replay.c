@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+/*
+ * Recording decoder. It only uses the record layout from recorder.h and the
+ * C library, so the same file builds on the target and, with RECORDER_HOST
+ * defined, in a host build that drives the control code from a recording.
+ */
+
+#include <string.h>
+#include <recorder.h>
+
+#if defined(RECORDER_HOST)
+#include <fcntl.h>
+#include <unistd.h>
+#define REPLAY_USING_FILE
+#elif defined(RT_USING_DFS)
+#include <dfs_posix.h>
+#define REPLAY_USING_FILE
+#endif
+
+#define REC_PAYLOAD_MAX     32
+
+static int replay_dispatch(const struct rec_header *hdr, const rt_uint8_t *payload,
+                           const struct rec_replay_ops *ops, void *user)
+{
+    /* payloads are copied out, records in a buffer are only byte aligned */
+    union
+    {
+        struct rec_encoder encoder;
+        struct rec_command command;
+        struct rec_imu imu;
+        struct rec_remote remote;
+    } rec;
+
+    switch (hdr->type)
+    {
+    case REC_CYCLE:
+        if (ops->cycle)
+            ops->cycle(hdr->tick, user);
+        break;
+
+    case REC_ENCODER:
+        if (hdr->length != sizeof(rec.encoder))
+            return -RT_ERROR;
+        memcpy(&rec, payload, sizeof(rec.encoder));
+        if (ops->encoder)
+            ops->encoder(hdr->tick, hdr->channel, &rec.encoder, user);
+        break;
+
+    case REC_COMMAND:
+        if (hdr->length != sizeof(rec.command))
+            return -RT_ERROR;
+        memcpy(&rec, payload, sizeof(rec.command));
+        if (ops->command)
+            ops->command(hdr->tick, &rec.command, user);
+        break;
+
+    case REC_IMU:
+        if (hdr->length != sizeof(rec.imu))
+            return -RT_ERROR;
+        memcpy(&rec, payload, sizeof(rec.imu));
+        if (ops->imu)
+            ops->imu(hdr->tick, hdr->channel, &rec.imu, user);
+        break;
+
+    case REC_REMOTE:
+        if (hdr->length != sizeof(rec.remote))
+            return -RT_ERROR;
+        memcpy(&rec, payload, sizeof(rec.remote));
+        if (ops->remote)
+            ops->remote(hdr->tick, &rec.remote, user);
+        break;
+
+    default:
+        /* unknown record types from newer recorders are skipped */
+        break;
+    }
+
+    return RT_EOK;
+}
+
+static int replay_check_file_header(const struct rec_file_header *fhdr)
+{
+    if (fhdr->magic != REC_MAGIC || fhdr->version != REC_VERSION)
+        return -RT_ERROR;
+
+    return RT_EOK;
+}
+
+int recorder_replay(const rt_uint8_t *buf, rt_size_t size, const struct rec_replay_ops *ops, void *user)
+{
+    int count = 0;
+    rt_size_t offset;
+    struct rec_header hdr;
+    struct rec_file_header fhdr;
+
+    if (size < sizeof(fhdr))
+        return -RT_ERROR;
+
+    memcpy(&fhdr, buf, sizeof(fhdr));
+    if (replay_check_file_header(&fhdr) != RT_EOK)
+        return -RT_ERROR;
+
+    offset = sizeof(fhdr);
+    while (offset + sizeof(hdr) <= size)
+    {
+        memcpy(&hdr, buf + offset, sizeof(hdr));
+        offset += sizeof(hdr);
+
+        /* a recording cut short by power loss ends on a partial record */
+        if (offset + hdr.length > size)
+            break;
+
+        if (replay_dispatch(&hdr, buf + offset, ops, user) != RT_EOK)
+            return -RT_ERROR;
+
+        offset += hdr.length;
+        count++;
+    }
+
+    return count;
+}
+
+#ifdef REPLAY_USING_FILE
+int recorder_replay_file(const char *path, const struct rec_replay_ops *ops, void *user)
+{
+    int fd, count = 0;
+    struct rec_header hdr;
+    struct rec_file_header fhdr;
+    rt_uint8_t payload[REC_PAYLOAD_MAX];
+
+    fd = open(path, O_RDONLY, 0);
+    if (fd < 0)
+        return -RT_EIO;
+
+    if (read(fd, &fhdr, sizeof(fhdr)) != sizeof(fhdr) ||
+        replay_check_file_header(&fhdr) != RT_EOK)
+    {
+        close(fd);
+        return -RT_ERROR;
+    }
+
+    while (read(fd, &hdr, sizeof(hdr)) == sizeof(hdr))
+    {
+        if (hdr.length > REC_PAYLOAD_MAX)
+        {
+            count = -RT_ERROR;
+            break;
+        }
+
+        if (read(fd, payload, hdr.length) != hdr.length)
+            break;
+
+        if (replay_dispatch(&hdr, payload, ops, user) != RT_EOK)
+        {
+            count = -RT_ERROR;
+            break;
+        }
+        count++;
+    }
+
+    close(fd);
+
+    return count;
+}
+#else
+int recorder_replay_file(const char *path, const struct rec_replay_ops *ops, void *user)
+{
+    return -RT_ENOSYS;
+}
+#endif /* REPLAY_USING_FILE */
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <recorder.h>
+
+#ifdef RT_USING_DFS
+#include <dfs_posix.h>
+#endif
+
+#ifdef RT_USING_POSIX_AIO
+#include <posix_aio.h>
+#endif
+
+#define DBG_SECTION_NAME  "rec"
+#define DBG_LEVEL         DBG_LOG
+#include <rtdbg.h>
+
+static rt_uint8_t rec_pool[RECORDER_RING_SIZE];
+static struct rt_ringbuffer rec_ring;
+#ifdef RT_USING_POSIX_AIO
+/* a chunk is filled from the ring while the other one is written */
+static rt_uint8_t rec_chunk[2][RECORDER_CHUNK_SIZE];
+static struct aiocb rec_aio[2];
+static int rec_slot = 0;
+static off_t rec_offset = 0;
+#else
+static rt_uint8_t rec_chunk[RECORDER_CHUNK_SIZE];
+#endif
+
+static struct rt_semaphore rec_sem;
+static struct rt_thread rec_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t rec_thread_stack[RECORDER_THREAD_STACK_SIZE];
+static volatile rt_bool_t rec_flushing = RT_FALSE;
+static volatile rt_bool_t rec_running = RT_FALSE;
+static int rec_fd = -1;
+
+static rt_uint32_t rec_records = 0;
+static rt_uint32_t rec_dropped = 0;
+static rt_uint32_t rec_flushed = 0;
+
+rt_bool_t recorder_is_running(void)
+{
+    return rec_running;
+}
+
+void recorder_write(rt_uint8_t type, rt_uint8_t channel, const void *payload, rt_uint16_t length)
+{
+    rt_base_t level;
+    rt_size_t data_len;
+    struct rec_header hdr;
+
+    if (!rec_running)
+        return;
+
+    hdr.tick    = rt_tick_get();
+    hdr.type    = type;
+    hdr.channel = channel;
+    hdr.length  = length;
+
+    /* header and payload go in together or not at all */
+    level = rt_hw_interrupt_disable();
+    if (rt_ringbuffer_space_len(&rec_ring) < sizeof(hdr) + length)
+    {
+        rec_dropped++;
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+    rt_ringbuffer_put(&rec_ring, (const rt_uint8_t *)&hdr, sizeof(hdr));
+    if (length)
+        rt_ringbuffer_put(&rec_ring, (const rt_uint8_t *)payload, length);
+    rec_records++;
+    data_len = rt_ringbuffer_data_len(&rec_ring);
+    rt_hw_interrupt_enable(level);
+
+    if (data_len >= RECORDER_RING_SIZE / 2)
+        rt_sem_release(&rec_sem);
+}
+
+void recorder_cycle(void)
+{
+    recorder_write(REC_CYCLE, 0, RT_NULL, 0);
+}
+
+void recorder_encoder(rt_uint8_t wheel, rt_int32_t delta)
+{
+    struct rec_encoder enc;
+
+    enc.delta = delta;
+    recorder_write(REC_ENCODER, wheel, &enc, sizeof(enc));
+}
+
+void recorder_command(float linear_x, float linear_y, float angular_z)
+{
+    struct rec_command cmd;
+
+    cmd.linear_x  = linear_x;
+    cmd.linear_y  = linear_y;
+    cmd.angular_z = angular_z;
+    recorder_write(REC_COMMAND, 0, &cmd, sizeof(cmd));
+}
+
+void recorder_imu(rt_uint8_t channel, const rt_int16_t acce[3], const rt_int16_t gyro[3])
+{
+    struct rec_imu imu;
+
+    rt_memcpy(imu.acce, acce, sizeof(imu.acce));
+    rt_memcpy(imu.gyro, gyro, sizeof(imu.gyro));
+    recorder_write(REC_IMU, channel, &imu, sizeof(imu));
+}
+
+void recorder_remote(rt_uint16_t buttons, const rt_uint8_t axis[4])
+{
+    struct rec_remote remote;
+
+    remote.buttons = buttons;
+    rt_memcpy(remote.axis, axis, sizeof(remote.axis));
+    recorder_write(REC_REMOTE, 0, &remote, sizeof(remote));
+}
+
+#ifdef RT_USING_DFS
+#ifdef RT_USING_POSIX_AIO
+static void recorder_wait(struct aiocb *cb)
+{
+    const struct aiocb *list[1] = {cb};
+
+    if (cb->aio_nbytes == 0)
+        return;
+
+    while (aio_error(cb) == -EINPROGRESS)
+        aio_suspend(list, 1, RT_NULL);
+    if (aio_return(cb) == (ssize_t)cb->aio_nbytes)
+        rec_flushed += cb->aio_nbytes;
+    cb->aio_nbytes = 0;
+}
+
+static void recorder_flush(void)
+{
+    struct aiocb *cb;
+    rt_base_t level;
+    rt_size_t length;
+
+    do
+    {
+        cb = &rec_aio[rec_slot];
+        recorder_wait(cb);
+
+        level = rt_hw_interrupt_disable();
+        length = rt_ringbuffer_get(&rec_ring, rec_chunk[rec_slot], RECORDER_CHUNK_SIZE);
+        rt_hw_interrupt_enable(level);
+        if (length == 0)
+            break;
+
+        cb->aio_fildes = rec_fd;
+        cb->aio_offset = rec_offset;
+        cb->aio_buf = rec_chunk[rec_slot];
+        cb->aio_nbytes = length;
+        cb->aio_sigevent.sigev_notify = SIGEV_NONE;
+        if (aio_write(cb) == 0)
+        {
+            rec_offset += length;
+            rec_slot ^= 1;
+        }
+        else
+        {
+            cb->aio_nbytes = 0;
+        }
+    } while (length == RECORDER_CHUNK_SIZE);
+}
+#else
+static void recorder_flush(void)
+{
+    rt_base_t level;
+    rt_size_t length;
+
+    do
+    {
+        level = rt_hw_interrupt_disable();
+        length = rt_ringbuffer_get(&rec_ring, rec_chunk, RECORDER_CHUNK_SIZE);
+        rt_hw_interrupt_enable(level);
+
+        if (length > 0 && write(rec_fd, rec_chunk, length) == (int)length)
+            rec_flushed += length;
+    } while (length == RECORDER_CHUNK_SIZE);
+}
+#endif /* RT_USING_POSIX_AIO */
+
+static void recorder_thread_entry(void *parameter)
+{
+    while (rec_running)
+    {
+        rt_sem_take(&rec_sem, RECORDER_FLUSH_PERIOD);
+        recorder_flush();
+    }
+
+    /* drain what was recorded before the stop */
+    recorder_flush();
+#ifdef RT_USING_POSIX_AIO
+    recorder_wait(&rec_aio[0]);
+    recorder_wait(&rec_aio[1]);
+#endif
+    close(rec_fd);
+    rec_fd = -1;
+}
+
+/* called by the idle thread right before the thread object is detached */
+static void recorder_thread_cleanup(struct rt_thread *thread)
+{
+    rec_flushing = RT_FALSE;
+}
+
+rt_err_t recorder_start(const char *path)
+{
+    struct rec_file_header fhdr;
+
+    if (rec_running || rec_flushing)
+        return -RT_EBUSY;
+
+    rec_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0);
+    if (rec_fd < 0)
+    {
+        LOG_E("Failed to open %s", path);
+        return -RT_EIO;
+    }
+
+    fhdr.magic           = REC_MAGIC;
+    fhdr.version         = REC_VERSION;
+    fhdr.tick_per_second = RT_TICK_PER_SECOND;
+    if (write(rec_fd, &fhdr, sizeof(fhdr)) != sizeof(fhdr))
+    {
+        LOG_E("Failed to write the header of %s", path);
+        close(rec_fd);
+        rec_fd = -1;
+        return -RT_EIO;
+    }
+
+    rt_ringbuffer_reset(&rec_ring);
+    rec_records = 0;
+    rec_dropped = 0;
+    rec_flushed = 0;
+#ifdef RT_USING_POSIX_AIO
+    rt_memset(rec_aio, 0, sizeof(rec_aio));
+    rec_slot = 0;
+    rec_offset = sizeof(fhdr);
+#endif
+
+    rec_running = RT_TRUE;
+    rec_flushing = RT_TRUE;
+    rt_thread_init(&rec_thread, "trec", recorder_thread_entry, RT_NULL,
+                   rec_thread_stack, RECORDER_THREAD_STACK_SIZE,
+                   RECORDER_THREAD_PRIORITY, RECORDER_THREAD_TIMESLICE);
+    /* a new recording waits until the thread object is no longer in use */
+    rec_thread.cleanup = recorder_thread_cleanup;
+    rt_thread_startup(&rec_thread);
+
+    return RT_EOK;
+}
+#else
+rt_err_t recorder_start(const char *path)
+{
+    LOG_E("Recording needs a file system (RT_USING_DFS)");
+    return -RT_ENOSYS;
+}
+#endif /* RT_USING_DFS */
+
+rt_err_t recorder_stop(void)
+{
+    if (!rec_running)
+        return -RT_ERROR;
+
+    rec_running = RT_FALSE;
+    rt_sem_release(&rec_sem);
+
+    return RT_EOK;
+}
+
+static int recorder_init(void)
+{
+    rt_ringbuffer_init(&rec_ring, rec_pool, RECORDER_RING_SIZE);
+    rt_sem_init(&rec_sem, "rec", 0, RT_IPC_FLAG_FIFO);
+
+    return 0;
+}
+INIT_APP_EXPORT(recorder_init);
+
+static void recorder(int argc, char *argv[])
+{
+    if (argc > 1 && !rt_strcmp(argv[1], "start"))
+    {
+        recorder_start(argc > 2 ? argv[2] : RECORDER_FILE);
+    }
+    else if (argc > 1 && !rt_strcmp(argv[1], "stop"))
+    {
+        recorder_stop();
+    }
+    else
+    {
+        rt_kprintf("Usage: recorder [start [file]|stop]\n");
+    }
+
+    rt_kprintf("recorder %s: %u records, %u dropped, %u bytes flushed\n",
+               rec_running ? "running" : "stopped", rec_records, rec_dropped, rec_flushed);
+}
+MSH_CMD_EXPORT(recorder, record chassis inputs to a file);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#ifndef __RECORDER_H__
+#define __RECORDER_H__
+
+#include <rtthread.h>
+
+/*
+ * Input recorder
+ *
+ * Every input crossing into the chassis layer is written as a compact binary
+ * record into a RAM ring, which a low priority thread flushes to a file on
+ * the mounted file system (QSPI flash or SD card). A recording starts with
+ * a struct rec_file_header followed by records, each a struct rec_header and
+ * 'length' bytes of payload, all little-endian.
+ *
+ * The decoder in record_replay.c only depends on this header, so it can be
+ * built on a host and feed a recording back into the control code as fast
+ * as the host runs.
+ */
+
+#define RECORDER_RING_SIZE          4096
+#define RECORDER_CHUNK_SIZE         512
+#define RECORDER_FLUSH_PERIOD       (RT_TICK_PER_SECOND / 10)
+#define RECORDER_FILE               "/record.bin"
+
+#define RECORDER_THREAD_PRIORITY    (RT_THREAD_PRIORITY_MAX - 4)
+#define RECORDER_THREAD_STACK_SIZE  1024
+#define RECORDER_THREAD_TIMESLICE   10
+
+#define REC_MAGIC                   0x43455252      /* "RREC" */
+#define REC_VERSION                 1
+
+enum rec_type
+{
+    REC_CYCLE = 0,                                  /* one control cycle ran */
+    REC_ENCODER,                                    /* encoder delta, channel = wheel */
+    REC_COMMAND,                                    /* velocity setpoint */
+    REC_IMU,                                        /* raw IMU sample */
+    REC_REMOTE,                                     /* remote pad state */
+    REC_TYPE_MAX
+};
+
+struct rec_file_header
+{
+    rt_uint32_t magic;
+    rt_uint16_t version;
+    rt_uint16_t tick_per_second;
+};
+
+struct rec_header
+{
+    rt_uint32_t tick;
+    rt_uint8_t  type;
+    rt_uint8_t  channel;
+    rt_uint16_t length;
+};
+
+struct rec_encoder
+{
+    rt_int32_t delta;
+};
+
+struct rec_command
+{
+    float linear_x;
+    float linear_y;
+    float angular_z;
+};
+
+struct rec_imu
+{
+    rt_int16_t acce[3];
+    rt_int16_t gyro[3];
+};
+
+struct rec_remote
+{
+    rt_uint16_t buttons;
+    rt_uint8_t  axis[4];
+};
+
+struct rec_replay_ops
+{
+    void (*cycle)(rt_uint32_t tick, void *user);
+    void (*encoder)(rt_uint32_t tick, rt_uint8_t channel, const struct rec_encoder *enc, void *user);
+    void (*command)(rt_uint32_t tick, const struct rec_command *cmd, void *user);
+    void (*imu)(rt_uint32_t tick, rt_uint8_t channel, const struct rec_imu *imu, void *user);
+    void (*remote)(rt_uint32_t tick, const struct rec_remote *remote, void *user);
+};
+
+rt_err_t recorder_start(const char *path);
+rt_err_t recorder_stop(void);
+rt_bool_t recorder_is_running(void);
+
+void recorder_write(rt_uint8_t type, rt_uint8_t channel, const void *payload, rt_uint16_t length);
+void recorder_cycle(void);
+void recorder_encoder(rt_uint8_t wheel, rt_int32_t delta);
+void recorder_command(float linear_x, float linear_y, float angular_z);
+void recorder_imu(rt_uint8_t channel, const rt_int16_t acce[3], const rt_int16_t gyro[3]);
+void recorder_remote(rt_uint16_t buttons, const rt_uint8_t axis[4]);
+
+/* returns the number of records replayed, or a negative error on a corrupt stream */
+int recorder_replay(const rt_uint8_t *buf, rt_size_t size, const struct rec_replay_ops *ops, void *user);
+int recorder_replay_file(const char *path, const struct rec_replay_ops *ops, void *user);
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <probe.h>
+
+/*
+ * Cycles per put and get of a block through the locked rt_ringbuffer path
+ * and both lock-free variants. The correctness and interrupt stress checks
+ * of the lock-free rings are the "drivers.lfring" utest testcase.
+ */
+
+#define RING_BENCH_SIZE         1024
+#define RING_BENCH_ROUNDS       1000
+#define RING_BENCH_BLOCK_MAX    256
+
+static rt_uint8_t ring_pool[RING_BENCH_SIZE];
+static rt_uint8_t ring_block[RING_BENCH_BLOCK_MAX];
+
+static struct rt_ringbuffer ring_rb;
+static struct rt_lfring ring_lf;
+
+static void ring_bench_speed(void)
+{
+    int i;
+    rt_base_t level;
+    rt_uint32_t size, start, locked, spsc, mp;
+
+    rt_kprintf("size  locked(cyc) spsc(cyc) mp(cyc)\n");
+    for (size = 16; size <= RING_BENCH_BLOCK_MAX; size <<= 1)
+    {
+        /* the current path: rt_ringbuffer under an interrupt lock */
+        rt_ringbuffer_init(&ring_rb, ring_pool, RING_BENCH_SIZE);
+        start = probe_cycles();
+        for (i = 0; i < RING_BENCH_ROUNDS; i++)
+        {
+            level = rt_hw_interrupt_disable();
+            rt_ringbuffer_put(&ring_rb, ring_block, size);
+            rt_hw_interrupt_enable(level);
+            level = rt_hw_interrupt_disable();
+            rt_ringbuffer_get(&ring_rb, ring_block, size);
+            rt_hw_interrupt_enable(level);
+        }
+        locked = (probe_cycles() - start) / RING_BENCH_ROUNDS;
+
+        rt_lfring_init(&ring_lf, ring_pool, RING_BENCH_SIZE);
+        start = probe_cycles();
+        for (i = 0; i < RING_BENCH_ROUNDS; i++)
+        {
+            rt_lfring_put(&ring_lf, ring_block, size);
+            rt_lfring_get(&ring_lf, ring_block, size);
+        }
+        spsc = (probe_cycles() - start) / RING_BENCH_ROUNDS;
+
+        rt_lfring_init(&ring_lf, ring_pool, RING_BENCH_SIZE);
+        start = probe_cycles();
+        for (i = 0; i < RING_BENCH_ROUNDS; i++)
+        {
+            rt_lfring_mp_put(&ring_lf, ring_block, size);
+            rt_lfring_mp_get(&ring_lf, ring_block, size);
+        }
+        mp = (probe_cycles() - start) / RING_BENCH_ROUNDS;
+
+        rt_kprintf("%4u  %11u %9u %7u\n", size, locked, spsc, mp);
+    }
+}
+
+static void ring_bench(int argc, char *argv[])
+{
+    ring_bench_speed();
+}
+MSH_CMD_EXPORT(ring_bench, cycles of locked and lock-free ring buffer put and get);
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+/*
+ * Cycles per call of rt_memcpy, rt_memmove and rt_memset over a size x
+ * alignment matrix. Build with and without RT_USING_HW_MEMCPY to compare the
+ * CPU port routines with the C fallback of kservice.c.
+ */
+
+#include <rtthread.h>
+#include <probe.h>
+
+#define STRING_BENCH_ROUNDS     20
+#define STRING_BENCH_SIZE_MAX   1024
+
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t string_bench_src[STRING_BENCH_SIZE_MAX + 8];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t string_bench_dst[STRING_BENCH_SIZE_MAX + 8];
+
+static const rt_ubase_t string_bench_sizes[] = {4, 16, 64, 256, 1024};
+
+/* destination and source offsets from a word boundary */
+static const rt_uint8_t string_bench_aligns[][2] = {{0, 0}, {0, 1}, {1, 0}, {2, 2}, {3, 1}};
+
+#define STRING_BENCH_NUM(array)  (sizeof(array) / sizeof(array[0]))
+
+static rt_uint32_t string_bench_copy(int op, rt_ubase_t size, int dst_off, int src_off)
+{
+    rt_uint8_t *dst = string_bench_dst + dst_off;
+    rt_uint8_t *src = string_bench_src + src_off;
+    rt_uint32_t start;
+    int i;
+
+    start = probe_cycles();
+    for (i = 0; i < STRING_BENCH_ROUNDS; i++)
+    {
+        switch (op)
+        {
+        case 0:
+            rt_memcpy(dst, src, size);
+            break;
+        case 1:
+            /* overlapping, copied backward */
+            rt_memmove(string_bench_src + 4 + dst_off, src, size);
+            break;
+        default:
+            rt_memset(dst, i, size);
+            break;
+        }
+    }
+
+    return (probe_cycles() - start) / STRING_BENCH_ROUNDS;
+}
+
+static void string_bench(int argc, char *argv[])
+{
+    static const char *names[] = {"rt_memcpy", "rt_memmove", "rt_memset"};
+    rt_ubase_t size;
+    int op, i, j;
+
+#ifdef RT_USING_HW_MEMCPY
+    rt_kprintf("CPU port routines (RT_USING_HW_MEMCPY)\n");
+#else
+    rt_kprintf("C fallback routines\n");
+#endif
+
+    for (op = 0; op < 3; op++)
+    {
+        rt_kprintf("%-10s   size", names[op]);
+        for (j = 0; j < STRING_BENCH_NUM(string_bench_aligns); j++)
+        {
+            if (op == 2)
+                rt_kprintf("     d+%d", string_bench_aligns[j][0]);
+            else
+                rt_kprintf("  d+%d/s+%d", string_bench_aligns[j][0], string_bench_aligns[j][1]);
+        }
+        rt_kprintf("\n");
+
+        for (i = 0; i < STRING_BENCH_NUM(string_bench_sizes); i++)
+        {
+            size = string_bench_sizes[i];
+            rt_kprintf("%17u", size);
+            for (j = 0; j < STRING_BENCH_NUM(string_bench_aligns); j++)
+            {
+                rt_kprintf(" %8u", string_bench_copy(op, size,
+                        string_bench_aligns[j][0], string_bench_aligns[j][1]));
+            }
+            rt_kprintf("\n");
+        }
+    }
+}
+MSH_CMD_EXPORT(string_bench, cycles of rt_memcpy/rt_memmove/rt_memset by size and alignment);
@@ -11,6 +11,7 @@
  * Date           Author       Notes
  * 2009-01-05     Bernard      first implementation
  * 2019-05-09     Zero-Free    Adding multiple configurations for system clock frequency
+ * 2026-10-19     yqiu         SRAM2 heap region and memory map report
  */
 
 #include <board.h>
@@ -229,3 +230,89 @@ void SystemClock_ReConfig(uint8_t mode)
 }
 
 #endif
+
+#ifdef BSP_USING_SRAM2
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+static struct rt_memheap sram2_heap;
+#endif
+
+/**
+ * This function will clear the data pinned to SRAM2 and add the rest of SRAM2
+ * as a heap region. It runs after the system heap initialization.
+ */
+void rt_hw_sram2_init(void)
+{
+#if !defined(__CC_ARM) && !defined(__CLANG_ARM) && !defined(__ICCARM__)
+    extern int __sram2_start;
+
+    /* .sram2 is not loaded, the startup code only clears .bss */
+    rt_memset(&__sram2_start, 0, (rt_uint8_t *)SRAM2_HEAP_BEGIN - (rt_uint8_t *)&__sram2_start);
+#endif
+
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+    rt_memheap_init(&sram2_heap, BSP_HEAP_SRAM2, SRAM2_HEAP_BEGIN,
+                    (rt_uint32_t)SRAM2_HEAP_END - (rt_uint32_t)SRAM2_HEAP_BEGIN);
+#endif
+}
+#endif
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static const char *memmap_region(void *addr)
+{
+    if ((rt_uint32_t)addr >= STM32_SRAM1_START && (rt_uint32_t)addr < STM32_SRAM1_END)
+        return "SRAM1";
+    if ((rt_uint32_t)addr >= STM32_SRAM2_START && (rt_uint32_t)addr < STM32_SRAM2_END)
+        return "SRAM2";
+
+    return "-";
+}
+
+static void memmap(void)
+{
+    struct rt_object_information *info;
+    struct rt_list_node *node;
+    struct rt_thread *thread;
+#ifdef RT_USING_MEMHEAP
+    struct rt_memheap *heap;
+#endif
+
+    rt_kprintf("region start      end        static     heap\n");
+    rt_kprintf("------ ---------- ---------- ---------- ----------\n");
+    rt_kprintf("SRAM1  0x%08x 0x%08x %-10d %d\n", STM32_SRAM1_START, STM32_SRAM1_END,
+               (rt_uint32_t)HEAP_BEGIN - STM32_SRAM1_START,
+               (rt_uint32_t)HEAP_END - (rt_uint32_t)HEAP_BEGIN);
+    rt_kprintf("SRAM2  0x%08x 0x%08x %-10d %d\n", STM32_SRAM2_START, STM32_SRAM2_END,
+               (rt_uint32_t)SRAM2_HEAP_BEGIN - STM32_SRAM2_START,
+               (rt_uint32_t)SRAM2_HEAP_END - (rt_uint32_t)SRAM2_HEAP_BEGIN);
+
+    rt_enter_critical();
+
+#ifdef RT_USING_MEMHEAP
+    rt_kprintf("\nheap     region start      size       used       max used\n");
+    rt_kprintf("-------- ------ ---------- ---------- ---------- ----------\n");
+    info = rt_object_get_information(RT_Object_Class_MemHeap);
+    rt_list_for_each(node, &(info->object_list))
+    {
+        heap = (struct rt_memheap *)rt_list_entry(node, struct rt_object, list);
+        rt_kprintf("%-*.*s %-6s 0x%08x %-10d %-10d %d\n", RT_NAME_MAX, RT_NAME_MAX,
+                   heap->parent.name, memmap_region(heap->start_addr), heap->start_addr,
+                   heap->pool_size, heap->pool_size - heap->available_size, heap->max_used_size);
+    }
+#endif
+
+    rt_kprintf("\nthread   region stack      size\n");
+    rt_kprintf("-------- ------ ---------- ----------\n");
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    rt_list_for_each(node, &(info->object_list))
+    {
+        thread = rt_list_entry(node, struct rt_thread, list);
+        rt_kprintf("%-*.*s %-6s 0x%08x %d\n", RT_NAME_MAX, RT_NAME_MAX, thread->name,
+                   memmap_region(thread->stack_addr), thread->stack_addr, thread->stack_size);
+    }
+
+    rt_exit_critical();
+}
+MSH_CMD_EXPORT(memmap, show the RAM regions and what is placed in them);
+#endif
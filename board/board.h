@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-5      SummerGift   first version
+ * 2026-10-19     yqiu         heap regions in SRAM1 and SRAM2, section attributes
  */
 
 #ifndef __BOARD_H__
@@ -28,8 +29,54 @@ extern "C" {
 #define STM32_SRAM1_START              (0x20000000)
 #define STM32_SRAM1_END                (STM32_SRAM1_START + STM32_SRAM1_SIZE * 1024)
 
-#define HEAP_BEGIN                     STM32_SRAM1_START
+#define STM32_SRAM2_SIZE               (32)
+#define STM32_SRAM2_START              (0x10000000)
+#define STM32_SRAM2_END                (STM32_SRAM2_START + STM32_SRAM2_SIZE * 1024)
+
+/*
+ * SRAM1 holds the data, the bss and the system heap. SRAM2 holds the main
+ * stack, the data pinned with BSP_SECTION_SRAM2, and the rest of it is a
+ * second heap region named "sram2".
+ */
+#if defined(__CC_ARM) || defined(__CLANG_ARM)
+extern int Image$$RW_IRAM1$$ZI$$Limit;
+extern int Image$$RW_IRAM2$$ZI$$Limit;
+#define HEAP_BEGIN                     ((void *)&Image$$RW_IRAM1$$ZI$$Limit)
+#define SRAM2_HEAP_BEGIN               ((void *)&Image$$RW_IRAM2$$ZI$$Limit)
+#elif defined(__ICCARM__)
+#pragma section="SRAM1_END"
+#pragma section="CSTACK"
+#define HEAP_BEGIN                     (__section_begin("SRAM1_END"))
+#define SRAM2_HEAP_BEGIN               (__section_end("CSTACK"))
+#else
+extern int __bss_end;
+extern int __sram2_end;
+#define HEAP_BEGIN                     ((void *)&__bss_end)
+#define SRAM2_HEAP_BEGIN               ((void *)&__sram2_end)
+#endif
+
 #define HEAP_END                       STM32_SRAM1_END
+#define SRAM2_HEAP_END                 STM32_SRAM2_END
+
+/* names of the heap regions for rt_malloc_region */
+#define BSP_HEAP_SRAM1                 "heap"
+#define BSP_HEAP_SRAM2                 "sram2"
+
+/*
+ * Pin an object into a RAM region, e.g.
+ *     static rt_uint8_t stack[512] BSP_SECTION_SRAM2;
+ * SRAM2 is for hot data such as the stacks and objects of control loops;
+ * SRAM1 for DMA buffers, so that DMA does not contend with the CPU on SRAM2.
+ * Pinned objects must not have an initializer, they are cleared at start.
+ */
+#ifdef BSP_USING_SRAM2
+#define BSP_SECTION_SRAM1              SECTION(".bss.sram1")
+#define BSP_SECTION_SRAM2              SECTION(".bss.sram2")
+#else
+#define BSP_SECTION_SRAM1
+#define BSP_SECTION_SRAM2
+#endif
+#define BSP_SECTION_DMA                BSP_SECTION_SRAM1
 
 void SystemClock_Config(void);
 void SystemClock_MSI_ON(void);
@@ -39,6 +86,10 @@ void SystemClock_24M(void);
 void SystemClock_2M(void);
 void SystemClock_ReConfig(uint8_t mode);
 
+#ifdef BSP_USING_SRAM2
+void rt_hw_sram2_init(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-27     zylx         first version
+ * 2026-10-19     yqiu         probe and mount the flash asynchronously
+ * 2026-10-19     yqiu         mount the flash through a block cache
  */
  
 #include <board.h>
@@ -72,26 +74,44 @@ static int rt_hw_qspi_flash_with_sfud_init(void)
 
     return RT_EOK;
 }
-INIT_COMPONENT_EXPORT(rt_hw_qspi_flash_with_sfud_init);
+INIT_ASYNC_EXPORT(rt_hw_qspi_flash_with_sfud_init, "4", RT_NULL);
 
 #if defined(RT_USING_DFS_ELMFAT) && !defined(BSP_USING_SDCARD)
 #include <dfs_fs.h>
+#ifdef RT_USING_DFS_BCACHE
+#include <dfs_bcache.h>
+#endif
 
 #define BLK_DEV_NAME  "W25Q128"
 
+/* the repeated FAT sector writes are merged in the cache before the erase */
+static const char *mnt_device(void)
+{
+#ifdef RT_USING_DFS_BCACHE
+    if (dfs_bcache_create("W25Qc", BLK_DEV_NAME) == RT_EOK)
+    {
+        return "W25Qc";
+    }
+#endif
+    return BLK_DEV_NAME;
+}
+
 int mnt_init(void)
 {
+    const char *device;
+
     rt_thread_delay(RT_TICK_PER_SECOND);
 
-    if (dfs_mount(BLK_DEV_NAME, "/", "elm", 0, 0) == 0)
+    device = mnt_device();
+    if (dfs_mount(device, "/", "elm", 0, 0) == 0)
     {
         rt_kprintf("file system initialization done!\n");
     }
     else
     {
-        if(dfs_mkfs("elm", BLK_DEV_NAME) == 0)
+        if(dfs_mkfs("elm", device) == 0)
         {
-            if (dfs_mount(BLK_DEV_NAME, "/", "elm", 0, 0) == 0)
+            if (dfs_mount(device, "/", "elm", 0, 0) == 0)
             {
                 rt_kprintf("file system initialization done!\n");
             }
@@ -104,7 +124,7 @@ int mnt_init(void)
 
     return 0;
 }
-INIT_ENV_EXPORT(mnt_init);
+INIT_ASYNC_EXPORT(mnt_init, "5", "rt_hw_qspi_flash_with_sfud_init");
 
 #endif /* defined(RT_USING_DFS_ELMFAT) && !defined(BSP_USING_SDCARD) */
 #endif /* BSP_USING_QSPI_FLASH */
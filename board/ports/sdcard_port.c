@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-12-14     balanceTWK   add sdcard port file
+ * 2026-10-19     yqiu         probe the card asynchronously
+ * 2026-10-19     yqiu         mount the card through a block cache
  */
 
 #include <rtthread.h>
@@ -17,11 +19,26 @@
 #include <dfs_posix.h>
 #include "drv_spi.h"
 #include "spi_msd.h"
+#ifdef RT_USING_DFS_BCACHE
+#include <dfs_bcache.h>
+#endif
 
 #define DBG_TAG "app.card"
 #define DBG_LVL DBG_INFO
 #include <rtdbg.h>
 
+/* the device to mount, the card itself if its cache can not be made */
+static const char *sd_device(void)
+{
+#ifdef RT_USING_DFS_BCACHE
+    if (rt_device_find("sd0c") != RT_NULL || dfs_bcache_create("sd0c", "sd0") == RT_EOK)
+    {
+        return "sd0c";
+    }
+#endif
+    return "sd0";
+}
+
 void sd_mount(void *parameter)
 {
     while (1)
@@ -29,7 +46,7 @@ void sd_mount(void *parameter)
         rt_thread_mdelay(500);
         if(rt_device_find("sd0") != RT_NULL)
         {
-            if (dfs_mount("sd0", "/", "elm", 0, 0) == RT_EOK)
+            if (dfs_mount(sd_device(), "/", "elm", 0, 0) == RT_EOK)
             {
                 LOG_I("sd card mount to '/'");
                 break;
@@ -66,7 +83,8 @@ static int rt_hw_spi1_tfcard(void)
     rt_hw_spi_device_attach("spi1", "spi10", GPIOC, GPIO_PIN_3);
     return msd_init("sd0", "spi10");
 }
-INIT_DEVICE_EXPORT(rt_hw_spi1_tfcard);
+/* sd_mount polls for sd0, so the card is probed asynchronously */
+INIT_ASYNC_EXPORT(rt_hw_spi1_tfcard, "3", RT_NULL);
 
 #endif /* BSP_USING_SDCARD */
 
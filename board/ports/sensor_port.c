@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2019-05-08     flaybreak    add sensor port file
+ * 2026-10-19     yqiu         probe the sensors asynchronously
  */
 
 #include <board.h>
@@ -26,7 +27,7 @@ int sensor_init(void)
 
     return 0;
 }
-INIT_ENV_EXPORT(sensor_init);
+INIT_ASYNC_EXPORT(sensor_init, "5", RT_NULL);
 
 #endif
 
@@ -46,5 +47,5 @@ int rt_hw_aht10_port(void)
 
     return RT_EOK;
 }
-INIT_ENV_EXPORT(rt_hw_aht10_port);
+INIT_ASYNC_EXPORT(rt_hw_aht10_port, "5", RT_NULL);
 #endif
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#ifndef __SOFTIRQ_CONFIG_H__
+#define __SOFTIRQ_CONFIG_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* an interrupt line without a peripheral in use, pended by software */
+#ifndef SOFTIRQ_IRQn
+#define SOFTIRQ_IRQn                SWPMI1_IRQn
+#define SOFTIRQ_IRQHandler          SWPMI1_IRQHandler
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SOFTIRQ_CONFIG_H__ */
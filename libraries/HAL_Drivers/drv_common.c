@@ -6,6 +6,9 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-7      SummerGift   first version
+ * 2026-10-19     yqiu         init deferred interrupt processing
+ * 2026-10-19     yqiu         init the SRAM2 region
+ * 2026-10-19     yqiu         boot time from the DWT cycle counter
  */
 
 #include "drv_common.h"
@@ -14,6 +17,10 @@
 #include "drv_usart.h"
 #endif
 
+#ifdef BSP_USING_SOFTIRQ
+#include "drv_softirq.h"
+#endif
+
 #ifdef RT_USING_FINSH
 #include <finsh.h>
 static void reboot(uint8_t argc, char **argv)
@@ -103,6 +110,38 @@ void rt_hw_us_delay(rt_uint32_t us)
     } while(delta < us_tick * us);
 }
 
+#ifdef ARCH_ARM_CORTEX_M4
+/**
+ * This function returns the microseconds since its first call, counted with
+ * the DWT cycle counter of the Cortex-M4 port. It must be called at least
+ * once per 2^32 cycles.
+ */
+rt_uint32_t rt_hw_boot_time_us(void)
+{
+    static rt_uint32_t last_cycle, boot_us, cycle_rest;
+    rt_uint32_t cycle, cycle_per_us;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        rt_hw_cycle_counter_enable();
+        last_cycle = DWT->CYCCNT;
+    }
+
+    /* the core clock changes during the board initialization */
+    cycle = DWT->CYCCNT;
+    cycle_per_us = SystemCoreClock / 1000000UL;
+    cycle_rest += cycle - last_cycle;
+    last_cycle = cycle;
+    boot_us += cycle_rest / cycle_per_us;
+    cycle_rest %= cycle_per_us;
+    rt_hw_interrupt_enable(level);
+
+    return boot_us;
+}
+#endif
+
 /**
  * This function will initial STM32 board.
  */
@@ -130,6 +169,16 @@ RT_WEAK void rt_hw_board_init()
     rt_system_heap_init((void *)HEAP_BEGIN, (void *)HEAP_END);
 #endif
 
+    /* Data pinned to SRAM2 and the second heap region */
+#ifdef BSP_USING_SRAM2
+    rt_hw_sram2_init();
+#endif
+
+    /* Deferred interrupt processing, used by the pin and USART drivers */
+#ifdef BSP_USING_SOFTIRQ
+    rt_hw_softirq_init();
+#endif
+
     /* Pin driver initialization is open by default */
 #ifdef RT_USING_PIN
     rt_hw_pin_init();
@@ -7,11 +7,16 @@
  * Date           Author            Notes
  * 2018-11-06     balanceTWK        first version
  * 2019-04-23     WillianChan       Fix GPIO serial number disorder
+ * 2026-10-19     yqiu              run pin handlers as deferred work
  */
 
 #include <board.h>
 #include "drv_gpio.h"
 
+#ifdef BSP_USING_SOFTIRQ
+#include "drv_softirq.h"
+#endif
+
 #ifdef RT_USING_PIN
 
 static const struct pin_index pins[] = 
@@ -615,6 +620,12 @@ rt_inline void pin_irq_hdr(int irqno)
 {
     if (pin_irq_hdr_tab[irqno].hdr)
     {
+#ifdef BSP_USING_SOFTIRQ
+        /* the EXTI flag is already cleared, run the handler after the ISR */
+        if (softirq_raise(SOFTIRQ_PRIO_NORMAL, pin_irq_hdr_tab[irqno].hdr,
+                          pin_irq_hdr_tab[irqno].args) == RT_EOK)
+            return;
+#endif
         pin_irq_hdr_tab[irqno].hdr(pin_irq_hdr_tab[irqno].args);
     }
 }
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rthw.h>
+#include <board.h>
+#include "drv_softirq.h"
+#include "drv_config.h"
+
+#ifdef BSP_USING_SOFTIRQ
+
+#ifndef SOFTIRQ_IRQn
+#error "Please define SOFTIRQ_IRQn and SOFTIRQ_IRQHandler in softirq_config.h"
+#endif
+
+struct softirq_work
+{
+    void (*func)(void *parameter);
+    void *parameter;
+    rt_uint32_t stamp;                      /* cycle count when raised */
+};
+
+struct softirq_queue
+{
+    struct softirq_work work[SOFTIRQ_QUEUE_SIZE];
+    rt_uint8_t head;                        /* next to run */
+    rt_uint8_t count;
+
+    struct softirq_stat stat;
+};
+
+static struct softirq_queue softirq_queues[SOFTIRQ_PRIO_NUM];
+
+rt_err_t softirq_raise(rt_uint8_t prio, void (*func)(void *parameter), void *parameter)
+{
+    rt_base_t level;
+    struct softirq_work *work;
+    struct softirq_queue *queue;
+
+    RT_ASSERT(prio < SOFTIRQ_PRIO_NUM);
+    RT_ASSERT(func != RT_NULL);
+
+    queue = &softirq_queues[prio];
+
+    level = rt_hw_interrupt_disable();
+    if (queue->count >= SOFTIRQ_QUEUE_SIZE)
+    {
+        queue->stat.dropped++;
+        rt_hw_interrupt_enable(level);
+
+        return -RT_EFULL;
+    }
+
+    work = &queue->work[(queue->head + queue->count) % SOFTIRQ_QUEUE_SIZE];
+    work->func      = func;
+    work->parameter = parameter;
+    work->stamp     = DWT->CYCCNT;
+    queue->count++;
+    queue->stat.queued++;
+    rt_hw_interrupt_enable(level);
+
+    NVIC_SetPendingIRQ(SOFTIRQ_IRQn);
+
+    return RT_EOK;
+}
+
+/* take the oldest item of the most urgent non-empty queue */
+static rt_bool_t softirq_next(struct softirq_work *work)
+{
+    rt_uint8_t prio;
+    rt_base_t level;
+    rt_uint32_t latency;
+    struct softirq_queue *queue;
+
+    level = rt_hw_interrupt_disable();
+    for (prio = 0; prio < SOFTIRQ_PRIO_NUM; prio++)
+    {
+        queue = &softirq_queues[prio];
+        if (queue->count == 0)
+            continue;
+
+        *work = queue->work[queue->head];
+        queue->head = (queue->head + 1) % SOFTIRQ_QUEUE_SIZE;
+        queue->count--;
+
+        queue->stat.run++;
+        latency = DWT->CYCCNT - work->stamp;
+        if (latency > queue->stat.max_latency)
+            queue->stat.max_latency = latency;
+        rt_hw_interrupt_enable(level);
+
+        return RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_FALSE;
+}
+
+void SOFTIRQ_IRQHandler(void)
+{
+    struct softirq_work work;
+
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    /* work items run with interrupts enabled and may be preempted by ISRs
+     * raising more work, which is picked up by this same loop */
+    while (softirq_next(&work))
+    {
+        work.func(work.parameter);
+    }
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
+
+void softirq_stat_get(rt_uint8_t prio, struct softirq_stat *stat)
+{
+    rt_base_t level;
+
+    RT_ASSERT(prio < SOFTIRQ_PRIO_NUM);
+
+    level = rt_hw_interrupt_disable();
+    *stat = softirq_queues[prio].stat;
+    rt_hw_interrupt_enable(level);
+}
+
+void softirq_stat_reset(void)
+{
+    rt_uint8_t prio;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    for (prio = 0; prio < SOFTIRQ_PRIO_NUM; prio++)
+    {
+        rt_memset(&softirq_queues[prio].stat, 0, sizeof(struct softirq_stat));
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+int rt_hw_softirq_init(void)
+{
+    /* the cycle counter stamps every work item for the latency statistics */
+    rt_hw_cycle_counter_enable();
+
+    /* above PendSV, below every peripheral interrupt */
+    HAL_NVIC_SetPriority(SOFTIRQ_IRQn, (1 << __NVIC_PRIO_BITS) - 2, 0);
+    HAL_NVIC_EnableIRQ(SOFTIRQ_IRQn);
+
+    return 0;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+static void softirq(int argc, char *argv[])
+{
+    rt_uint8_t prio;
+    struct softirq_stat stat;
+    const char *names[SOFTIRQ_PRIO_NUM] = {"high", "normal", "low"};
+
+    rt_kprintf("queue   queued     run        dropped    max latency(cycle)\n");
+    rt_kprintf("------ ---------- ---------- ---------- ------------------\n");
+    for (prio = 0; prio < SOFTIRQ_PRIO_NUM; prio++)
+    {
+        softirq_stat_get(prio, &stat);
+        rt_kprintf("%-6s %10u %10u %10u %18u\n", names[prio],
+                   stat.queued, stat.run, stat.dropped, stat.max_latency);
+    }
+
+    if (argc > 1 && !rt_strcmp(argv[1], "-r"))
+        softirq_stat_reset();
+}
+MSH_CMD_EXPORT(softirq, show deferred interrupt work statistics [-r reset]);
+#endif
+
+#endif /* BSP_USING_SOFTIRQ */
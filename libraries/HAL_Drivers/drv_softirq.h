@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#ifndef __DRV_SOFTIRQ_H__
+#define __DRV_SOFTIRQ_H__
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <drv_common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Deferred interrupt processing
+ *
+ * A driver ISR does only what the hardware needs right now and raises the
+ * rest as a work item on one of the softirq queues. The queues are drained by
+ * a spare interrupt line pended by software, whose priority is the lowest one
+ * above PendSV: it runs once every hardware ISR has returned and before the
+ * PendSV context switch lets any thread resume. Queues are served strictly in
+ * priority order, items of one queue in the order they were raised.
+ */
+
+enum
+{
+    SOFTIRQ_PRIO_HIGH = 0,                  /* serial RX and other data paths */
+    SOFTIRQ_PRIO_NORMAL,                    /* pin interrupts */
+    SOFTIRQ_PRIO_LOW,
+    SOFTIRQ_PRIO_NUM
+};
+
+#define SOFTIRQ_QUEUE_SIZE      16          /* work items per priority */
+
+struct softirq_stat
+{
+    rt_uint32_t queued;
+    rt_uint32_t run;
+    rt_uint32_t dropped;                    /* raised on a full queue */
+    rt_uint32_t max_latency;                /* CPU cycles from raise to run */
+};
+
+int rt_hw_softirq_init(void);
+
+rt_err_t softirq_raise(rt_uint8_t prio, void (*func)(void *parameter), void *parameter);
+void softirq_stat_get(rt_uint8_t prio, struct softirq_stat *stat);
+void softirq_stat_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DRV_SOFTIRQ_H__ */
@@ -6,12 +6,17 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-10-30     SummerGift   first version
+ * 2026-10-19     yqiu         receive in a deferred bottom half
  */
  
 #include "board.h"
 #include "drv_usart.h"
 #include "drv_config.h"
 
+#ifdef BSP_USING_SOFTIRQ
+#include "drv_softirq.h"
+#endif
+
 #ifdef RT_USING_SERIAL
 
 //#define DRV_DEBUG
@@ -232,6 +237,24 @@ static const struct rt_uart_ops stm32_uart_ops =
  *
  * @param serial serial device
  */
+#ifdef BSP_USING_SOFTIRQ
+/* bottom half of RX: drain the data register, then unmask RXNE again */
+static void uart_rx_bottom_half(void *parameter)
+{
+    struct stm32_uart *uart;
+    struct rt_serial_device *serial = (struct rt_serial_device *)parameter;
+
+    uart = (struct stm32_uart *) serial->parent.user_data;
+
+    /* the device may have been closed meanwhile */
+    if (!(serial->parent.open_flag & RT_DEVICE_FLAG_INT_RX))
+        return;
+
+    rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_IND);
+    __HAL_UART_ENABLE_IT(&(uart->handle), UART_IT_RXNE);
+}
+#endif
+
 static void uart_isr(struct rt_serial_device *serial)
 {
     struct stm32_uart *uart;
@@ -249,7 +272,19 @@ static void uart_isr(struct rt_serial_device *serial)
     if ((__HAL_UART_GET_FLAG(&(uart->handle), UART_FLAG_RXNE) != RESET) &&
         (__HAL_UART_GET_IT_SOURCE(&(uart->handle), UART_IT_RXNE) != RESET))
     {
+#ifdef BSP_USING_SOFTIRQ
+        /* RXNE stays masked until the bottom half has read the data */
+        if (softirq_raise(SOFTIRQ_PRIO_HIGH, uart_rx_bottom_half, serial) == RT_EOK)
+        {
+            __HAL_UART_DISABLE_IT(&(uart->handle), UART_IT_RXNE);
+        }
+        else
+        {
+            rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_IND);
+        }
+#else
         rt_hw_serial_isr(serial, RT_SERIAL_EVENT_RX_IND);
+#endif
     }
 #ifdef RT_SERIAL_USING_DMA
     else if ((uart->uart_dma_flag) && (__HAL_UART_GET_FLAG(&(uart->handle), UART_FLAG_IDLE) != RESET) &&
@@ -305,10 +340,13 @@ static void uart_isr(struct rt_serial_device *serial)
         {
             UART_INSTANCE_CLEAR_FUNCTION(&(uart->handle), UART_FLAG_TC);
         }
+#ifndef BSP_USING_SOFTIRQ
+        /* with softirq, a masked RXNE holds data for the bottom half */
         if (__HAL_UART_GET_FLAG(&(uart->handle), UART_FLAG_RXNE) != RESET)
         {
             UART_INSTANCE_CLEAR_FUNCTION(&(uart->handle), UART_FLAG_RXNE);
         }
+#endif
     }
 }
 
@@ -15,6 +15,7 @@
  * 2017-02-13     Hichard      Update Fatfs version to 0.12b, support exFAT.
  * 2017-04-11     Bernard      fix the st_blksize issue.
  * 2017-05-26     Urey         fix f_mount error when mount more fats
+ * 2026-10-19     yqiu         cluster link map for the fast seek.
  */
 
 #include <rtthread.h>
@@ -31,6 +32,69 @@
 
 static rt_device_t disk[_VOLUMES] = {0};
 
+#ifndef RT_DFS_ELM_FASTSEEK_FRAGS
+#define RT_DFS_ELM_FASTSEEK_FRAGS   32
+#endif
+
+#if _USE_FASTSEEK && RT_DFS_ELM_FASTSEEK_FRAGS > 0
+/* the smallest file mapped, in clusters */
+#define ELM_FASTSEEK_MIN_CLUSTERS   4
+
+#if _MAX_SS != _MIN_SS
+#define ELM_SECTOR_SIZE(fs)         ((fs)->ssize)
+#else
+#define ELM_SECTOR_SIZE(fs)         _MAX_SS
+#endif
+
+/*
+ * The cluster link map table of a file lets f_lseek and f_read find a
+ * cluster without following the FAT chain. FatFs can not extend a file with
+ * a map, so the map is dropped before a write past the end of the file and
+ * made again on the next seek.
+ */
+static void elm_map_create(FIL *fd)
+{
+    FATFS *fs = fd->obj.fs;
+    DWORD *tbl;
+
+    if (fd->cltbl != RT_NULL ||
+        f_size(fd) <= (FSIZE_t)fs->csize * ELM_SECTOR_SIZE(fs) * ELM_FASTSEEK_MIN_CLUSTERS)
+        return;
+
+    /* the size, a length and top pair for each fragment and the terminator */
+    tbl = (DWORD *)rt_malloc((2 + 2 * RT_DFS_ELM_FASTSEEK_FRAGS) * sizeof(DWORD));
+    if (tbl == RT_NULL)
+        return;
+    tbl[0] = 2 + 2 * RT_DFS_ELM_FASTSEEK_FRAGS;
+
+    fd->cltbl = tbl;
+    if (f_lseek(fd, CREATE_LINKMAP) != FR_OK)
+    {
+        /* too fragmented, keep walking the chain */
+        fd->cltbl = RT_NULL;
+        rt_free(tbl);
+        return;
+    }
+
+    /* shrink the table to the items used */
+    tbl = (DWORD *)rt_realloc(tbl, tbl[0] * sizeof(DWORD));
+    if (tbl != RT_NULL)
+        fd->cltbl = tbl;
+}
+
+static void elm_map_delete(FIL *fd)
+{
+    if (fd->cltbl != RT_NULL)
+    {
+        rt_free(fd->cltbl);
+        fd->cltbl = RT_NULL;
+    }
+}
+#else
+#define elm_map_create(fd)
+#define elm_map_delete(fd)
+#endif
+
 static int elm_result_to_dfs(FRESULT result)
 {
     int status = RT_EOK;
@@ -426,6 +490,10 @@ int dfs_elm_open(struct dfs_fd *file)
             file->size = f_size(fd);
             file->data = fd;
 
+            /* a writer gets its map on the first seek */
+            if (!(mode & FA_WRITE))
+                elm_map_create(fd);
+
             if (file->flags & O_APPEND)
             {
                 /* seek to the end of file */
@@ -465,6 +533,7 @@ int dfs_elm_close(struct dfs_fd *file)
         fd = (FIL *)(file->data);
         RT_ASSERT(fd != RT_NULL);
 
+        elm_map_delete(fd);
         result = f_close(fd);
         if (result == FR_OK)
         {
@@ -518,6 +587,10 @@ int dfs_elm_write(struct dfs_fd *file, const void *buf, size_t len)
     fd = (FIL *)(file->data);
     RT_ASSERT(fd != RT_NULL);
 
+    /* the chain can not grow with a map */
+    if (fd->fptr + len > f_size(fd))
+        elm_map_delete(fd);
+
     result = f_write(fd, buf, len, &byte_write);
     /* update position and file size */
     file->pos  = fd->fptr;
@@ -551,6 +624,12 @@ int dfs_elm_lseek(struct dfs_fd *file, rt_off_t offset)
         fd = (FIL *)(file->data);
         RT_ASSERT(fd != RT_NULL);
 
+        /* a map clips the offset at the end of the file */
+        if (offset > f_size(fd))
+            elm_map_delete(fd);
+        else
+            elm_map_create(fd);
+
         result = f_lseek(fd, offset);
         if (result == FR_OK)
         {
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         the first version
+ */
+
+#ifndef __DFS_BCACHE_H__
+#define __DFS_BCACHE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct dfs_bcache_stats
+{
+    rt_uint32_t hit;            /* sectors read from the cache */
+    rt_uint32_t miss;           /* sectors read from the device */
+    rt_uint32_t readahead;      /* sectors read ahead of a sequential read */
+    rt_uint32_t write;          /* sectors written by the file system */
+    rt_uint32_t writeback;      /* sectors written to the device */
+    rt_uint32_t device_read;    /* read transfers of the device */
+    rt_uint32_t device_write;   /* write transfers of the device */
+};
+
+rt_err_t dfs_bcache_create(const char *name, const char *device_name);
+rt_err_t dfs_bcache_get_stats(const char *name, struct dfs_bcache_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -25,4 +25,10 @@ extern const struct dfs_mount_tbl mount_table[];
 
 extern char working_directory[];
 
+#ifdef DFS_USING_PATH_CACHE
+void dfs_path_cache_invalidate(const char *path);
+#else
+#define dfs_path_cache_invalidate(path)
+#endif
+
 #endif
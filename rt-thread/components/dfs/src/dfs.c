@@ -8,6 +8,7 @@
  * 2005-02-22     Bernard      The first version.
  * 2017-12-11     Bernard      Use rt_free to instead of free in fd_is_open().
  * 2018-03-20     Heyuanjie    dynamic allocation FD
+ * 2026-10-19     yqiu         look the path of fd_is_open up through dfs_path_lookup.
  */
 
 #include <dfs.h>
@@ -294,11 +295,10 @@ int fd_is_open(const char *pathname)
     struct dfs_fdtable *fdt;
 
     fdt = dfs_fdtable_get();
-    fullpath = dfs_normalize_path(NULL, pathname);
+    fs = dfs_path_lookup(pathname, &fullpath);
     if (fullpath != NULL)
     {
         char *mountpath;
-        fs = dfs_filesystem_lookup(fullpath);
         if (fs == NULL)
         {
             /* can't find mounted file system */
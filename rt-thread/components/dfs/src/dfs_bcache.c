@@ -0,0 +1,546 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <dfs_bcache.h>
+
+#ifndef RT_DFS_BCACHE_SECTORS
+#define RT_DFS_BCACHE_SECTORS       8
+#endif
+#ifndef RT_DFS_BCACHE_BURST_SIZE
+#define RT_DFS_BCACHE_BURST_SIZE    4096
+#endif
+
+#define BCACHE_SECTOR_NONE          0xFFFFFFFF
+
+/*
+ * A block cache is a block device stacked on another one, a file system
+ * mounted on it gets an LRU of sector buffers between its sector accesses
+ * and the device:
+ *
+ * - A read missing the cache reads the missing run of sectors in one
+ *   transfer. When the read continues the previous one, the transfer goes on
+ *   ahead up to a burst, so the next small reads hit.
+ * - A write only updates the buffers. The dirty sectors go to the device,
+ *   sorted and merged into runs of up to a burst, when a dirty buffer is
+ *   reused, on RT_DEVICE_CTRL_BLK_SYNC and on close.
+ * - A transfer of half the cache or more bypasses it, so streaming a file
+ *   does not flush out the FAT and directory sectors.
+ */
+struct bcache_entry
+{
+    rt_list_t list;                     /* in the LRU list, the most recent first */
+    struct bcache_entry *next;          /* in the hash bucket */
+    rt_uint32_t sector;
+    rt_bool_t dirty;
+    rt_uint8_t *data;
+};
+
+struct dfs_bcache
+{
+    struct rt_device parent;
+    rt_device_t device;                 /* the cached device */
+    struct rt_mutex lock;
+    struct dfs_bcache *next;
+
+    rt_uint32_t sector_size;
+    rt_uint32_t sector_count;
+    rt_uint32_t entry_num;
+    rt_uint32_t burst;                  /* sectors of the staging buffer */
+    rt_uint32_t hash_mask;
+    rt_uint32_t next_sector;            /* the sector after the last read */
+
+    rt_list_t lru;
+    struct bcache_entry *entries;
+    struct bcache_entry **hash;
+    struct bcache_entry **dirty;        /* the flush sorts the dirty entries here */
+    rt_uint8_t *staging;
+
+    struct dfs_bcache_stats stats;
+};
+
+static struct dfs_bcache *bcache_list;
+
+rt_inline struct bcache_entry **bcache_bucket(struct dfs_bcache *cache, rt_uint32_t sector)
+{
+    return &cache->hash[sector & cache->hash_mask];
+}
+
+static struct bcache_entry *bcache_lookup(struct dfs_bcache *cache, rt_uint32_t sector)
+{
+    struct bcache_entry *entry;
+
+    for (entry = *bcache_bucket(cache, sector); entry != RT_NULL; entry = entry->next)
+    {
+        if (entry->sector == sector)
+            return entry;
+    }
+
+    return RT_NULL;
+}
+
+static void bcache_unhash(struct dfs_bcache *cache, struct bcache_entry *entry)
+{
+    struct bcache_entry **iter;
+
+    for (iter = bcache_bucket(cache, entry->sector); *iter != entry; iter = &(*iter)->next);
+    *iter = entry->next;
+    entry->sector = BCACHE_SECTOR_NONE;
+}
+
+/* write back the dirty sectors in ascending runs */
+static rt_err_t bcache_flush(struct dfs_bcache *cache)
+{
+    struct bcache_entry *entry;
+    rt_uint32_t num = 0, i, j, run;
+    const void *data;
+
+    for (i = 0; i < cache->entry_num; i++)
+    {
+        entry = &cache->entries[i];
+        if (!entry->dirty)
+            continue;
+
+        for (j = num++; j > 0 && cache->dirty[j - 1]->sector > entry->sector; j--)
+            cache->dirty[j] = cache->dirty[j - 1];
+        cache->dirty[j] = entry;
+    }
+
+    for (i = 0; i < num; i += run)
+    {
+        for (run = 1; i + run < num && run < cache->burst; run++)
+        {
+            if (cache->dirty[i + run]->sector != cache->dirty[i]->sector + run)
+                break;
+        }
+
+        if (run == 1)
+        {
+            data = cache->dirty[i]->data;
+        }
+        else
+        {
+            for (j = 0; j < run; j++)
+            {
+                rt_memcpy(cache->staging + j * cache->sector_size, cache->dirty[i + j]->data,
+                        cache->sector_size);
+            }
+            data = cache->staging;
+        }
+
+        cache->stats.device_write++;
+        if (rt_device_write(cache->device, cache->dirty[i]->sector, data, run) != run)
+            return -RT_EIO;
+
+        for (j = 0; j < run; j++)
+            cache->dirty[i + j]->dirty = RT_FALSE;
+        cache->stats.writeback += run;
+    }
+
+    return RT_EOK;
+}
+
+/* the least recently used entry, made the most recent one for the sector */
+static struct bcache_entry *bcache_alloc(struct dfs_bcache *cache, rt_uint32_t sector)
+{
+    struct bcache_entry *entry;
+    struct bcache_entry **bucket;
+
+    entry = rt_list_entry(cache->lru.prev, struct bcache_entry, list);
+    if (entry->dirty && bcache_flush(cache) != RT_EOK)
+        return RT_NULL;
+
+    if (entry->sector != BCACHE_SECTOR_NONE)
+        bcache_unhash(cache, entry);
+
+    bucket = bcache_bucket(cache, sector);
+    entry->sector = sector;
+    entry->next = *bucket;
+    *bucket = entry;
+
+    rt_list_remove(&entry->list);
+    rt_list_insert_after(&cache->lru, &entry->list);
+
+    return entry;
+}
+
+rt_inline void bcache_touch(struct dfs_bcache *cache, struct bcache_entry *entry)
+{
+    rt_list_remove(&entry->list);
+    rt_list_insert_after(&cache->lru, &entry->list);
+}
+
+/* drop the sectors from first to last, dirty or not */
+static void bcache_invalidate(struct dfs_bcache *cache, rt_uint32_t first, rt_uint32_t last)
+{
+    struct bcache_entry *entry;
+    rt_uint32_t i;
+
+    for (i = 0; i < cache->entry_num; i++)
+    {
+        entry = &cache->entries[i];
+        if (entry->sector == BCACHE_SECTOR_NONE || entry->sector < first || entry->sector > last)
+            continue;
+
+        bcache_unhash(cache, entry);
+        entry->dirty = RT_FALSE;
+        rt_list_remove(&entry->list);
+        rt_list_insert_before(&cache->lru, &entry->list);
+    }
+}
+
+/* read a run of missing sectors, with the read-ahead after them */
+static rt_bool_t bcache_fill(struct dfs_bcache *cache, rt_uint32_t sector, rt_uint8_t *buf,
+        rt_uint32_t count, rt_uint32_t ahead)
+{
+    struct bcache_entry *entry;
+    rt_uint32_t i, total = count + ahead;
+
+    cache->stats.device_read++;
+    cache->stats.miss += count;
+
+    if (ahead == 0)
+    {
+        if (rt_device_read(cache->device, sector, buf, count) != count)
+            return RT_FALSE;
+
+        for (i = 0; i < count && count < cache->entry_num / 2; i++)
+        {
+            entry = bcache_alloc(cache, sector + i);
+            if (entry == RT_NULL)
+                break;
+            rt_memcpy(entry->data, buf + i * cache->sector_size, cache->sector_size);
+        }
+        return RT_TRUE;
+    }
+
+    /* the entries first, a write back in between would reuse the staging buffer */
+    for (i = 0; i < total; i++)
+    {
+        if (bcache_alloc(cache, sector + i) == RT_NULL)
+        {
+            if (i > 0)
+                bcache_invalidate(cache, sector, sector + i - 1);
+            return rt_device_read(cache->device, sector, buf, count) == count;
+        }
+    }
+
+    if (rt_device_read(cache->device, sector, cache->staging, total) != total)
+    {
+        bcache_invalidate(cache, sector, sector + total - 1);
+        return RT_FALSE;
+    }
+
+    for (i = 0; i < total; i++)
+    {
+        entry = bcache_lookup(cache, sector + i);
+        rt_memcpy(entry->data, cache->staging + i * cache->sector_size, cache->sector_size);
+    }
+    rt_memcpy(buf, cache->staging, count * cache->sector_size);
+    cache->stats.readahead += ahead;
+
+    return RT_TRUE;
+}
+
+static rt_err_t bcache_init(rt_device_t dev)
+{
+    return RT_EOK;
+}
+
+static rt_err_t bcache_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    struct dfs_bcache *cache = (struct dfs_bcache *)dev;
+
+    return rt_device_open(cache->device, RT_DEVICE_OFLAG_RDWR);
+}
+
+static rt_err_t bcache_close(rt_device_t dev)
+{
+    struct dfs_bcache *cache = (struct dfs_bcache *)dev;
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    bcache_flush(cache);
+    rt_mutex_release(&cache->lock);
+
+    return rt_device_close(cache->device);
+}
+
+static rt_size_t bcache_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    struct dfs_bcache *cache = (struct dfs_bcache *)dev;
+    struct bcache_entry *entry;
+    rt_uint8_t *buf = (rt_uint8_t *)buffer;
+    rt_uint32_t i, run, ahead;
+    rt_bool_t sequential;
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    sequential = (pos == cache->next_sector);
+
+    for (i = 0; i < size; i += run)
+    {
+        entry = bcache_lookup(cache, pos + i);
+        if (entry != RT_NULL)
+        {
+            rt_memcpy(buf + i * cache->sector_size, entry->data, cache->sector_size);
+            bcache_touch(cache, entry);
+            cache->stats.hit++;
+            run = 1;
+            continue;
+        }
+
+        for (run = 1; i + run < size && bcache_lookup(cache, pos + i + run) == RT_NULL; run++);
+
+        /* go on to a burst at the end of a sequential read */
+        ahead = 0;
+        if (sequential && i + run == size)
+        {
+            while (run + ahead < cache->burst && pos + size + ahead < cache->sector_count &&
+                    bcache_lookup(cache, pos + size + ahead) == RT_NULL)
+            {
+                ahead++;
+            }
+        }
+
+        if (!bcache_fill(cache, pos + i, buf + i * cache->sector_size, run, ahead))
+            break;
+    }
+
+    cache->next_sector = pos + size;
+    rt_mutex_release(&cache->lock);
+
+    return i < size ? i : size;
+}
+
+static rt_size_t bcache_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    struct dfs_bcache *cache = (struct dfs_bcache *)dev;
+    struct bcache_entry *entry;
+    const rt_uint8_t *buf = (const rt_uint8_t *)buffer;
+    rt_size_t i;
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    cache->stats.write += size;
+
+    if (size >= cache->entry_num / 2)
+    {
+        /* the old copies are stale, dirty or not */
+        bcache_invalidate(cache, pos, pos + size - 1);
+        cache->stats.device_write++;
+        cache->stats.writeback += size;
+        i = rt_device_write(cache->device, pos, buffer, size);
+    }
+    else
+    {
+        for (i = 0; i < size; i++)
+        {
+            entry = bcache_lookup(cache, pos + i);
+            if (entry == RT_NULL)
+            {
+                entry = bcache_alloc(cache, pos + i);
+                if (entry == RT_NULL)
+                    break;
+            }
+            else
+            {
+                bcache_touch(cache, entry);
+            }
+
+            rt_memcpy(entry->data, buf + i * cache->sector_size, cache->sector_size);
+            entry->dirty = RT_TRUE;
+        }
+    }
+    rt_mutex_release(&cache->lock);
+
+    return i;
+}
+
+static rt_err_t bcache_control(rt_device_t dev, int cmd, void *args)
+{
+    struct dfs_bcache *cache = (struct dfs_bcache *)dev;
+    rt_err_t result = RT_EOK;
+
+    switch (cmd)
+    {
+    case RT_DEVICE_CTRL_BLK_SYNC:
+        rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+        result = bcache_flush(cache);
+        rt_mutex_release(&cache->lock);
+        if (result != RT_EOK)
+            return result;
+        break;
+
+    case RT_DEVICE_CTRL_BLK_ERASE:
+        /* the first and the last sector */
+        rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+        bcache_invalidate(cache, ((rt_uint32_t *)args)[0], ((rt_uint32_t *)args)[1]);
+        rt_mutex_release(&cache->lock);
+        break;
+
+    default:
+        break;
+    }
+
+    return rt_device_control(cache->device, cmd, args);
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops bcache_ops =
+{
+    bcache_init,
+    bcache_open,
+    bcache_close,
+    bcache_read,
+    bcache_write,
+    bcache_control
+};
+#endif
+
+/**
+ * This function registers a block device caching another one.
+ *
+ * @param name the name of the cache device
+ * @param device_name the name of the cached block device
+ *
+ * @return RT_EOK on successful, otherwise the error code.
+ */
+rt_err_t dfs_bcache_create(const char *name, const char *device_name)
+{
+    struct dfs_bcache *cache;
+    struct rt_device_blk_geometry geometry;
+    rt_device_t device;
+    rt_uint32_t i, hash_num;
+
+    device = rt_device_find(device_name);
+    if (device == RT_NULL || device->type != RT_Device_Class_Block)
+        return -RT_ERROR;
+
+    rt_memset(&geometry, 0, sizeof(geometry));
+    rt_device_control(device, RT_DEVICE_CTRL_BLK_GETGEOME, &geometry);
+    if (geometry.sector_count == 0 || geometry.bytes_per_sector == 0)
+        return -RT_ERROR;
+
+    cache = (struct dfs_bcache *)rt_calloc(1, sizeof(struct dfs_bcache));
+    if (cache == RT_NULL)
+        return -RT_ENOMEM;
+
+    cache->device = device;
+    cache->sector_size = geometry.bytes_per_sector;
+    cache->sector_count = geometry.sector_count;
+    /* in sectors, a byte size would leave few buffers of large sectors */
+    cache->entry_num = RT_DFS_BCACHE_SECTORS;
+    if (cache->entry_num < 4)
+        cache->entry_num = 4;
+    /* a burst never reuses an entry of itself */
+    cache->burst = RT_DFS_BCACHE_BURST_SIZE / cache->sector_size;
+    if (cache->burst > cache->entry_num / 2)
+        cache->burst = cache->entry_num / 2;
+    if (cache->burst == 0)
+        cache->burst = 1;
+    for (hash_num = 1; hash_num < cache->entry_num; hash_num <<= 1);
+    cache->hash_mask = hash_num - 1;
+    cache->next_sector = BCACHE_SECTOR_NONE;
+
+    cache->entries = (struct bcache_entry *)rt_calloc(cache->entry_num, sizeof(struct bcache_entry));
+    cache->hash = (struct bcache_entry **)rt_calloc(hash_num, sizeof(struct bcache_entry *));
+    cache->dirty = (struct bcache_entry **)rt_calloc(cache->entry_num, sizeof(struct bcache_entry *));
+    cache->staging = (rt_uint8_t *)rt_malloc((cache->entry_num + cache->burst) * cache->sector_size);
+    if (cache->entries == RT_NULL || cache->hash == RT_NULL || cache->dirty == RT_NULL ||
+            cache->staging == RT_NULL)
+    {
+        rt_free(cache->entries);
+        rt_free(cache->hash);
+        rt_free(cache->dirty);
+        rt_free(cache->staging);
+        rt_free(cache);
+        return -RT_ENOMEM;
+    }
+
+    /* the sector buffers follow the staging buffer */
+    rt_list_init(&cache->lru);
+    for (i = 0; i < cache->entry_num; i++)
+    {
+        cache->entries[i].sector = BCACHE_SECTOR_NONE;
+        cache->entries[i].data = cache->staging + (cache->burst + i) * cache->sector_size;
+        rt_list_insert_before(&cache->lru, &cache->entries[i].list);
+    }
+    rt_mutex_init(&cache->lock, name, RT_IPC_FLAG_FIFO);
+
+    cache->parent.type = RT_Device_Class_Block;
+#ifdef RT_USING_DEVICE_OPS
+    cache->parent.ops = &bcache_ops;
+#else
+    cache->parent.init = bcache_init;
+    cache->parent.open = bcache_open;
+    cache->parent.close = bcache_close;
+    cache->parent.read = bcache_read;
+    cache->parent.write = bcache_write;
+    cache->parent.control = bcache_control;
+#endif
+
+    cache->next = bcache_list;
+    bcache_list = cache;
+
+    return rt_device_register(&cache->parent, name, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_STANDALONE);
+}
+
+/**
+ * This function gets the statistics of a block cache.
+ *
+ * @param name the name of the cache device
+ * @param stats the statistics
+ *
+ * @return RT_EOK on successful, -RT_ERROR if there is no such cache.
+ */
+rt_err_t dfs_bcache_get_stats(const char *name, struct dfs_bcache_stats *stats)
+{
+    struct dfs_bcache *cache;
+
+    for (cache = bcache_list; cache != RT_NULL; cache = cache->next)
+    {
+        if (rt_strncmp(cache->parent.parent.name, name, RT_NAME_MAX) == 0)
+        {
+            rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+            *stats = cache->stats;
+            rt_mutex_release(&cache->lock);
+            return RT_EOK;
+        }
+    }
+
+    return -RT_ERROR;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void bcache(int argc, char **argv)
+{
+    struct dfs_bcache *cache;
+    struct dfs_bcache_stats stats;
+    rt_uint32_t total;
+
+    rt_kprintf("cache    device   buffers  hit/miss(%%)             ahead    write     back      reads    writes\n");
+    rt_kprintf("-------- -------- -------- ------------------------ -------- --------- --------- -------- --------\n");
+    for (cache = bcache_list; cache != RT_NULL; cache = cache->next)
+    {
+        rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+        stats = cache->stats;
+        rt_mutex_release(&cache->lock);
+
+        total = stats.hit + stats.miss;
+        rt_kprintf("%-8.*s %-8.*s %3dx%-4d %9d/%-9d(%3d) %-8d %-9d %-9d %-8d %-8d\n",
+                RT_NAME_MAX, cache->parent.parent.name, RT_NAME_MAX, cache->device->parent.name,
+                cache->entry_num, cache->sector_size, stats.hit, stats.miss,
+                total ? (int)((rt_uint64_t)stats.hit * 100 / total) : 0,
+                stats.readahead, stats.write, stats.writeback, stats.device_read, stats.device_write);
+    }
+}
+MSH_CMD_EXPORT(bcache, list block caches and their hit statistics);
+#endif /* RT_USING_FINSH */
@@ -9,6 +9,7 @@
  * 2011-12-08     Bernard      Merges rename patch from iamcacy.
  * 2015-05-27     Bernard      Fix the fd clear issue.
  * 2019-01-24     Bernard      Remove file repeatedly open check.
+ * 2026-10-19     yqiu         look the paths up through dfs_path_lookup.
  */
 
 #include <dfs.h>
@@ -40,8 +41,8 @@ int dfs_file_open(struct dfs_fd *fd, const char *path, int flags)
     if (fd == NULL)
         return -EINVAL;
 
-    /* make sure we have an absolute path */
-    fullpath = dfs_normalize_path(NULL, path);
+    /* make sure we have an absolute path and find filesystem */
+    fs = dfs_path_lookup(path, &fullpath);
     if (fullpath == NULL)
     {
         return -ENOMEM;
@@ -49,8 +50,6 @@ int dfs_file_open(struct dfs_fd *fd, const char *path, int flags)
 
     LOG_D("open file:%s", fullpath);
 
-    /* find filesystem */
-    fs = dfs_filesystem_lookup(fullpath);
     if (fs == NULL)
     {
         rt_free(fullpath); /* release path */
@@ -242,15 +241,14 @@ int dfs_file_unlink(const char *path)
     char *fullpath;
     struct dfs_filesystem *fs;
 
-    /* Make sure we have an absolute path */
-    fullpath = dfs_normalize_path(NULL, path);
+    /* Make sure we have an absolute path and get filesystem */
+    fs = dfs_path_lookup(path, &fullpath);
     if (fullpath == NULL)
     {
         return -EINVAL;
     }
 
-    /* get filesystem */
-    if ((fs = dfs_filesystem_lookup(fullpath)) == NULL)
+    if (fs == NULL)
     {
         result = -ENOENT;
         goto __exit;
@@ -361,13 +359,13 @@ int dfs_file_stat(const char *path, struct stat *buf)
     char *fullpath;
     struct dfs_filesystem *fs;
 
-    fullpath = dfs_normalize_path(NULL, path);
+    fs = dfs_path_lookup(path, &fullpath);
     if (fullpath == NULL)
     {
         return -1;
     }
 
-    if ((fs = dfs_filesystem_lookup(fullpath)) == NULL)
+    if (fs == NULL)
     {
         LOG_E(
                 "can't find mounted filesystem on this path:%s", fullpath);
@@ -435,24 +433,25 @@ int dfs_file_rename(const char *oldpath, const char *newpath)
     newfullpath = NULL;
     oldfullpath = NULL;
 
-    oldfullpath = dfs_normalize_path(NULL, oldpath);
+    oldfs = dfs_path_lookup(oldpath, &oldfullpath);
     if (oldfullpath == NULL)
     {
         result = -ENOENT;
         goto __exit;
     }
 
-    newfullpath = dfs_normalize_path(NULL, newpath);
+    newfs = dfs_path_lookup(newpath, &newfullpath);
     if (newfullpath == NULL)
     {
         result = -ENOENT;
         goto __exit;
     }
 
-    oldfs = dfs_filesystem_lookup(oldfullpath);
-    newfs = dfs_filesystem_lookup(newfullpath);
-
-    if (oldfs == newfs)
+    if (oldfs == NULL)
+    {
+        result = -ENOENT;
+    }
+    else if (oldfs == newfs)
     {
         if (oldfs->ops->rename == NULL)
         {
@@ -467,6 +466,13 @@ int dfs_file_rename(const char *oldpath, const char *newpath)
                 result = oldfs->ops->rename(oldfs,
                                             dfs_subdir(oldfs->path, oldfullpath),
                                             dfs_subdir(newfs->path, newfullpath));
+
+            if (result == RT_EOK)
+            {
+                /* the cached names under both paths are out of date */
+                dfs_path_cache_invalidate(oldfullpath);
+                dfs_path_cache_invalidate(newfullpath);
+            }
         }
     }
     else
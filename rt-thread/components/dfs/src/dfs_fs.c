@@ -10,6 +10,7 @@
  * 2011-03-12     Bernard      fix the filesystem lookup issue.
  * 2017-11-30     Bernard      fix the filesystem_operation_table issue.
  * 2017-12-05     Bernard      fix the fs type search issue in mkfs.
+ * 2026-10-19     yqiu         cache the recent path lookups.
  */
 
 #include <dfs_fs.h>
@@ -113,6 +114,170 @@ struct dfs_filesystem *dfs_filesystem_lookup(const char *path)
     return fs;
 }
 
+#ifdef DFS_USING_PATH_CACHE
+#ifndef DFS_PATH_CACHE_NUM
+#define DFS_PATH_CACHE_NUM      8
+#endif
+
+/*
+ * The recent lookups of dfs_path_lookup(), from the path as given, after the
+ * working directory for a relative one, to the normalized path and its file
+ * system. The result only depends on the mount table, so mount and unmount
+ * drop the entries under the mount point, and rename drops the ones under
+ * the old and the new name.
+ */
+struct dfs_path_cache_entry
+{
+    uint32_t hash;
+    char *key;                      /* the path as given, then the full path */
+    char *fullpath;
+    struct dfs_filesystem *fs;
+};
+
+static struct dfs_path_cache_entry path_cache[DFS_PATH_CACHE_NUM];
+static int path_cache_next;
+
+static uint32_t path_hash(uint32_t hash, const char *str)
+{
+    while (*str)
+        hash = (hash ^ (uint8_t)*str++) * 16777619;
+
+    return hash;
+}
+
+/* the key is the directory, a '/' and the file name, or the file name */
+static int path_cache_match(const char *key, const char *directory, const char *filename)
+{
+    if (directory != NULL)
+    {
+        while (*directory)
+        {
+            if (*key++ != *directory++)
+                return 0;
+        }
+        if (*key++ != '/')
+            return 0;
+    }
+
+    return strcmp(key, filename) == 0;
+}
+
+static void path_cache_insert(uint32_t hash, const char *directory, const char *filename,
+                              const char *fullpath, struct dfs_filesystem *fs)
+{
+    struct dfs_path_cache_entry *entry;
+    size_t dirlen, keylen;
+
+    dirlen = (directory != NULL) ? strlen(directory) + 1 : 0;
+    keylen = dirlen + strlen(filename) + 1;
+
+    entry = &path_cache[path_cache_next];
+    path_cache_next = (path_cache_next + 1) % DFS_PATH_CACHE_NUM;
+
+    rt_free(entry->key);
+    entry->key = rt_malloc(keylen + strlen(fullpath) + 1);
+    if (entry->key == NULL)
+        return;
+
+    if (directory != NULL)
+    {
+        strcpy(entry->key, directory);
+        entry->key[dirlen - 1] = '/';
+    }
+    strcpy(entry->key + dirlen, filename);
+    entry->fullpath = entry->key + keylen;
+    strcpy(entry->fullpath, fullpath);
+    entry->hash = hash;
+    entry->fs = fs;
+}
+
+/**
+ * this function will drop the cached lookups of the paths at or under the
+ * specified path.
+ *
+ * @param path the normalized path.
+ */
+void dfs_path_cache_invalidate(const char *path)
+{
+    struct dfs_path_cache_entry *entry;
+    size_t len;
+
+    len = strlen(path);
+    if (len == 1)
+        len = 0; /* "/" is the prefix of all */
+
+    dfs_lock();
+    for (entry = &path_cache[0]; entry < &path_cache[DFS_PATH_CACHE_NUM]; entry++)
+    {
+        if ((entry->key == NULL) || (strncmp(entry->fullpath, path, len) != 0) ||
+            (entry->fullpath[len] != '/' && entry->fullpath[len] != '\0'))
+            continue;
+
+        rt_free(entry->key);
+        entry->key = NULL;
+    }
+    dfs_unlock();
+}
+#endif
+
+/**
+ * this function will normalize a path and return the file system it is on.
+ *
+ * @param path the specified path string.
+ * @param fullpath the normalized path, to be released with rt_free.
+ *
+ * @return the found file system or NULL if the path is invalid or no file
+ * system mounted on it.
+ */
+struct dfs_filesystem *dfs_path_lookup(const char *path, char **fullpath)
+{
+    struct dfs_filesystem *fs = NULL;
+#ifdef DFS_USING_PATH_CACHE
+    struct dfs_path_cache_entry *entry;
+    const char *directory = NULL;
+    uint32_t hash = 2166136261;
+
+    RT_ASSERT(path);
+
+#ifdef DFS_USING_WORKDIR
+    if (path[0] != '/')
+        directory = &working_directory[0];
+#endif
+
+    /* the working directory does not change in the lock */
+    dfs_lock();
+    if (directory != NULL)
+        hash = path_hash(path_hash(hash, directory), "/");
+    hash = path_hash(hash, path);
+
+    for (entry = &path_cache[0]; entry < &path_cache[DFS_PATH_CACHE_NUM]; entry++)
+    {
+        if ((entry->key != NULL) && (entry->hash == hash) &&
+            path_cache_match(entry->key, directory, path))
+        {
+            *fullpath = rt_strdup(entry->fullpath);
+            if (*fullpath != NULL)
+                fs = entry->fs;
+            dfs_unlock();
+
+            return fs;
+        }
+    }
+#endif
+
+    *fullpath = dfs_normalize_path(NULL, path);
+    if (*fullpath != NULL)
+        fs = dfs_filesystem_lookup(*fullpath);
+
+#ifdef DFS_USING_PATH_CACHE
+    if (fs != NULL)
+        path_cache_insert(hash, directory, path, *fullpath, fs);
+    dfs_unlock();
+#endif
+
+    return fs;
+}
+
 /**
  * this function will return the mounted path for specified device.
  *
@@ -324,6 +489,8 @@ int dfs_mount(const char   *device_name,
             /* The underlaying device has error, clear the entry. */
             dfs_lock();
             memset(fs, 0, sizeof(struct dfs_filesystem));
+            /* the lookups since the entry was registered found it */
+            dfs_path_cache_invalidate(fullpath);
 
             goto err1;
         }
@@ -340,10 +507,14 @@ int dfs_mount(const char   *device_name,
         dfs_lock();
         /* clear filesystem table entry */
         memset(fs, 0, sizeof(struct dfs_filesystem));
+        dfs_path_cache_invalidate(fullpath);
 
         goto err1;
     }
 
+    /* the paths under the mount point are on this file system now */
+    dfs_path_cache_invalidate(fullpath);
+
     return 0;
 
 err1:
@@ -399,6 +570,8 @@ int dfs_unmount(const char *specialfile)
     if (fs->dev_id != NULL)
         rt_device_close(fs->dev_id);
 
+    dfs_path_cache_invalidate(fullpath);
+
     if (fs->path != NULL)
         rt_free(fs->path);
 
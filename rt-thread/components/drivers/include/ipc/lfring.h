@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+#ifndef LFRING_H__
+#define LFRING_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <rtthread.h>
+
+/*
+ * Lock-free ring buffers
+ *
+ * The indexes are free-running 32 bit counters and the buffer size is a
+ * power of two, so "index & (size - 1)" is the position in the buffer and
+ * "head - tail" is the amount of data, without any mirror bit.
+ *
+ * rt_lfring_put/get is a byte stream for exactly one producer and one
+ * consumer, e.g. an ISR and a thread. Each side only writes its own index
+ * and publishes it with a memory barrier after the data, so neither side
+ * needs to mask interrupts.
+ *
+ * rt_lfring_mp_put/get is a record queue for many producers (threads and
+ * ISRs) and one consumer. Producers claim space by advancing 'reserve' with
+ * an exclusive-access compare-and-swap, write their record and then mark its
+ * header committed. The consumer stops at the first uncommitted record, so
+ * a producer preempted in the middle of a write never blocks the others.
+ * The consumer zeroes every record it frees, so a header in claimed but not
+ * yet written space always reads as uncommitted.
+ */
+struct rt_lfring
+{
+    rt_uint8_t *buffer_ptr;
+    rt_uint32_t buffer_size;
+
+    volatile rt_uint32_t head;                  /* written by the producer */
+    volatile rt_uint32_t tail;                  /* written by the consumer */
+    volatile rt_uint32_t reserve;               /* claimed by producers, mp only */
+};
+
+void rt_lfring_init(struct rt_lfring *rb, rt_uint8_t *pool, rt_uint32_t size);
+void rt_lfring_reset(struct rt_lfring *rb);
+
+/* single producer, single consumer byte stream */
+rt_size_t rt_lfring_put(struct rt_lfring *rb, const rt_uint8_t *ptr, rt_uint32_t length);
+rt_size_t rt_lfring_get(struct rt_lfring *rb, rt_uint8_t *ptr, rt_uint32_t length);
+
+/* multiple producers, single consumer records */
+rt_size_t rt_lfring_mp_put(struct rt_lfring *rb, const rt_uint8_t *ptr, rt_uint16_t length);
+rt_size_t rt_lfring_mp_get(struct rt_lfring *rb, rt_uint8_t *ptr, rt_uint16_t length);
+
+/* amount of data in a single producer byte stream */
+rt_inline rt_uint32_t rt_lfring_data_len(struct rt_lfring *rb)
+{
+    return rb->head - rb->tail;
+}
+
+#define rt_lfring_space_len(rb) ((rb)->buffer_size - rt_lfring_data_len(rb))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -5,6 +5,8 @@
  *
  * Change Logs:
  * Date           Author       Notes
+ * 2026-10-19     yqiu         multiple workers, work priority, delayed work heap
+ *                             and statistics
  */
 #ifndef WORKQUEUE_H__
 #define WORKQUEUE_H__
@@ -25,14 +27,62 @@ enum
     RT_WORK_TYPE_DELAYED     = 0x0001,
 };
 
+/* the smaller the value, the earlier a pending work runs */
+#define RT_WORK_PRIORITY_HIGHEST        0
+#define RT_WORK_PRIORITY_DEFAULT        128
+#define RT_WORK_PRIORITY_LOWEST         255
+
+#ifndef RT_WORKQUEUE_DELAYED_MAX
+#define RT_WORKQUEUE_DELAYED_MAX        16  /* delayed work waiting for timeout */
+#endif
+
+#ifndef RT_WORKQUEUE_STAT_MAX
+#define RT_WORKQUEUE_STAT_MAX           8   /* work functions with own statistics */
+#endif
+
+struct rt_work;
+struct rt_delayed_work;
+
+/* statistics of one work function, times in OS ticks */
+struct rt_work_stat
+{
+    void (*work_func)(struct rt_work *work, void *work_data);
+
+    rt_uint32_t count;
+    rt_uint32_t wait_total;                 /* from submit to start */
+    rt_uint32_t wait_max;
+    rt_uint32_t exec_total;
+    rt_uint32_t exec_max;
+};
+
+struct rt_workqueue_worker
+{
+    rt_thread_t thread;
+    struct rt_workqueue *queue;
+    struct rt_work *work_current;           /* current work of this worker */
+};
+
 /* workqueue implementation */
 struct rt_workqueue
 {
-    rt_list_t      work_list;
-    struct rt_work *work_current; /* current work */
+    rt_list_t      list;                    /* on the list of all workqueues */
+    rt_list_t      work_list;               /* pending work, by priority */
+
+    struct rt_semaphore sem;                /* work completion */
+    struct rt_semaphore work_sem;           /* pending work for the workers */
 
-    struct rt_semaphore sem;
-    rt_thread_t    work_thread;
+    rt_uint8_t     worker_num;
+    struct rt_workqueue_worker *workers;
+
+    /* delayed work, a binary min-heap on the timeout tick */
+    struct rt_delayed_work **delayed_heap;  /* RT_WORKQUEUE_DELAYED_MAX entries */
+    rt_uint32_t    delayed_num;
+    struct rt_timer delayed_timer;
+
+    rt_uint16_t    depth;                   /* number of pending work */
+    rt_uint16_t    depth_max;
+    struct rt_work_stat stat[RT_WORKQUEUE_STAT_MAX];
+    rt_uint32_t    stat_missed;             /* runs of functions without a slot */
 };
 
 struct rt_work
@@ -43,12 +93,15 @@ struct rt_work
     void *work_data;
     rt_uint16_t flags;
     rt_uint16_t type;
+    rt_uint8_t priority;
+    rt_tick_t submit_tick;
 };
 
 struct rt_delayed_work
 {
     struct rt_work work;
-    struct rt_timer timer;
+    rt_tick_t timeout_tick;
+    rt_uint32_t heap_index;                 /* position in the delayed heap */
     struct rt_workqueue *workqueue;
 };
 
@@ -57,6 +110,8 @@ struct rt_delayed_work
  * WorkQueue for DeviceDriver
  */
 struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority);
+struct rt_workqueue *rt_workqueue_create_workers(const char *name, rt_uint16_t stack_size, rt_uint8_t priority,
+                                                 rt_uint8_t worker_num);
 rt_err_t rt_workqueue_destroy(struct rt_workqueue *queue);
 rt_err_t rt_workqueue_dowork(struct rt_workqueue *queue, struct rt_work *work);
 rt_err_t rt_workqueue_submit_work(struct rt_workqueue *queue, struct rt_work *work, rt_tick_t time);
@@ -76,6 +131,14 @@ rt_inline void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_wo
     work->work_data = work_data;
     work->flags = 0;
     work->type = 0;
+    work->priority = RT_WORK_PRIORITY_DEFAULT;
+    work->submit_tick = 0;
+}
+
+/* takes effect on the next submit */
+rt_inline void rt_work_set_priority(struct rt_work *work, rt_uint8_t priority)
+{
+    work->priority = priority;
 }
 
 void rt_delayed_work_init(struct rt_delayed_work *work, void (*work_func)(struct rt_work *work,
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <rtdevice.h>
+#include <string.h>
+
+#define LFRING_HDR_SIZE     sizeof(rt_uint32_t)
+#define LFRING_COMMIT       0x80000000          /* record is complete */
+#define LFRING_PADDING      0x40000000          /* filler up to the end of the buffer */
+#define LFRING_LEN_MASK     0x3FFFFFFF
+
+void rt_lfring_init(struct rt_lfring *rb, rt_uint8_t *pool, rt_uint32_t size)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(pool != RT_NULL);
+    /* the size must be a power of two and keep records word aligned */
+    RT_ASSERT(size >= LFRING_HDR_SIZE && (size & (size - 1)) == 0);
+
+    rb->buffer_ptr  = pool;
+    rb->buffer_size = size;
+    rt_lfring_reset(rb);
+}
+RTM_EXPORT(rt_lfring_init);
+
+void rt_lfring_reset(struct rt_lfring *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    rb->head = rb->tail = rb->reserve = 0;
+    memset(rb->buffer_ptr, 0, rb->buffer_size);
+}
+RTM_EXPORT(rt_lfring_reset);
+
+/**
+ * put a block of data into the ring buffer, only one context may put
+ *
+ * @return the length put, less than length when the ring is full
+ */
+rt_size_t rt_lfring_put(struct rt_lfring *rb, const rt_uint8_t *ptr, rt_uint32_t length)
+{
+    rt_uint32_t head, offset, first;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    head = rb->head;
+    first = rb->buffer_size - (head - rb->tail);
+    if (length > first)
+        length = first;
+    if (length == 0)
+        return 0;
+
+    /* the consumer finished reading this space before it moved the tail */
+    rt_hw_dmb();
+
+    offset = head & (rb->buffer_size - 1);
+    first = rb->buffer_size - offset;
+    if (first > length)
+        first = length;
+    memcpy(&rb->buffer_ptr[offset], ptr, first);
+    memcpy(&rb->buffer_ptr[0], &ptr[first], length - first);
+
+    /* publish the data before the new head */
+    rt_hw_dmb();
+    rb->head = head + length;
+
+    return length;
+}
+RTM_EXPORT(rt_lfring_put);
+
+/**
+ * get a block of data from the ring buffer, only one context may get
+ *
+ * @return the length got, less than length when the ring runs empty
+ */
+rt_size_t rt_lfring_get(struct rt_lfring *rb, rt_uint8_t *ptr, rt_uint32_t length)
+{
+    rt_uint32_t tail, offset, first;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    tail = rb->tail;
+    first = rb->head - tail;
+    if (length > first)
+        length = first;
+    if (length == 0)
+        return 0;
+
+    /* read the data only after the head which published it */
+    rt_hw_dmb();
+
+    offset = tail & (rb->buffer_size - 1);
+    first = rb->buffer_size - offset;
+    if (first > length)
+        first = length;
+    memcpy(ptr, &rb->buffer_ptr[offset], first);
+    memcpy(&ptr[first], &rb->buffer_ptr[0], length - first);
+
+    /* free the space only after it has been read */
+    rt_hw_dmb();
+    rb->tail = tail + length;
+
+    return length;
+}
+RTM_EXPORT(rt_lfring_get);
+
+/**
+ * put one record into the ring buffer, safe from any number of threads and
+ * interrupts at the same time
+ *
+ * @return the record length, or 0 when there is no room for the whole record
+ */
+rt_size_t rt_lfring_mp_put(struct rt_lfring *rb, const rt_uint8_t *ptr, rt_uint16_t length)
+{
+    rt_uint32_t reserve, offset, pad, need;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    need = RT_ALIGN(LFRING_HDR_SIZE + length, LFRING_HDR_SIZE);
+    if (need > rb->buffer_size)
+        return 0;
+
+    /* claim the space, a record never wraps so pad up to the end first */
+    do
+    {
+        reserve = rb->reserve;
+        offset = reserve & (rb->buffer_size - 1);
+        pad = (offset + need > rb->buffer_size) ? rb->buffer_size - offset : 0;
+
+        if (rb->buffer_size - (reserve - rb->tail) < pad + need)
+            return 0;
+    } while (rt_hw_atomic_cas(&rb->reserve, reserve, reserve + pad + need) != reserve);
+
+    if (pad)
+    {
+        *(volatile rt_uint32_t *)&rb->buffer_ptr[offset] = LFRING_COMMIT | LFRING_PADDING | pad;
+        offset = 0;
+    }
+
+    memcpy(&rb->buffer_ptr[offset + LFRING_HDR_SIZE], ptr, length);
+
+    /* commit the header only after the payload */
+    rt_hw_dmb();
+    *(volatile rt_uint32_t *)&rb->buffer_ptr[offset] = LFRING_COMMIT | length;
+
+    return length;
+}
+RTM_EXPORT(rt_lfring_mp_put);
+
+/**
+ * get one record from the ring buffer, only one context may get. A record
+ * longer than length is truncated.
+ *
+ * @return the length got, or 0 when no committed record is available
+ */
+rt_size_t rt_lfring_mp_get(struct rt_lfring *rb, rt_uint8_t *ptr, rt_uint16_t length)
+{
+    rt_uint32_t tail, offset, header, size;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    while (1)
+    {
+        tail = rb->tail;
+        if (tail == rb->reserve)
+            return 0;
+
+        offset = tail & (rb->buffer_size - 1);
+        header = *(volatile rt_uint32_t *)&rb->buffer_ptr[offset];
+
+        /* the producer of the oldest record is still writing it */
+        if (!(header & LFRING_COMMIT))
+            return 0;
+
+        /* read the payload only after its committed header */
+        rt_hw_dmb();
+
+        if (header & LFRING_PADDING)
+        {
+            size = header & LFRING_LEN_MASK;
+        }
+        else
+        {
+            size = header & LFRING_LEN_MASK;
+            if (length > size)
+                length = size;
+            memcpy(ptr, &rb->buffer_ptr[offset + LFRING_HDR_SIZE], length);
+            size = RT_ALIGN(LFRING_HDR_SIZE + size, LFRING_HDR_SIZE);
+        }
+
+        /* freed space must read as uncommitted to the next lap */
+        memset(&rb->buffer_ptr[offset], 0, size);
+        rt_hw_dmb();
+        rb->tail = tail + size;
+
+        if (!(header & LFRING_PADDING))
+            return length;
+    }
+}
+RTM_EXPORT(rt_lfring_mp_get);
@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2017-02-27     bernard      fix the re-work issue.
+ * 2026-10-19     yqiu         multiple workers, work priority, delayed work heap
+ *                             and statistics
  */
 
 #include <rthw.h>
@@ -14,6 +16,12 @@
 
 #ifdef RT_USING_HEAP
 
+#ifndef RT_SYSTEM_WORKQUEUE_WORKERS
+#define RT_SYSTEM_WORKQUEUE_WORKERS     1
+#endif
+
+static rt_list_t _workqueue_list = RT_LIST_OBJECT_INIT(_workqueue_list);
+
 static void _delayed_work_timeout_handler(void *parameter);
 
 rt_inline rt_err_t _workqueue_work_completion(struct rt_workqueue *queue)
@@ -47,37 +55,126 @@ rt_inline rt_err_t _workqueue_work_completion(struct rt_workqueue *queue)
     return result;
 }
 
+/* interrupt shall be disabled */
+static rt_bool_t _workqueue_is_current(struct rt_workqueue *queue, struct rt_work *work)
+{
+    rt_uint8_t index;
+
+    for (index = 0; index < queue->worker_num; index ++)
+    {
+        if (queue->workers[index].work_current == work)
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/* interrupt shall be disabled */
+static void _workqueue_unlink(struct rt_workqueue *queue, struct rt_work *work)
+{
+    if (!rt_list_isempty(&(work->list)))
+    {
+        rt_list_remove(&(work->list));
+        queue->depth --;
+    }
+}
+
+/*
+ * Insert the work behind the last pending work of the same or a more urgent
+ * priority, so that work of one priority runs in FIFO order.
+ * interrupt shall be disabled
+ */
+static void _workqueue_enqueue(struct rt_workqueue *queue, struct rt_work *work)
+{
+    rt_list_t *node;
+
+    /* NOTE: the work MUST be initialized firstly */
+    _workqueue_unlink(queue, work);
+
+    for (node = queue->work_list.prev; node != &(queue->work_list); node = node->prev)
+    {
+        if (rt_list_entry(node, struct rt_work, list)->priority <= work->priority)
+            break;
+    }
+    rt_list_insert_after(node, &(work->list));
+    work->submit_tick = rt_tick_get();
+
+    queue->depth ++;
+    if (queue->depth > queue->depth_max)
+        queue->depth_max = queue->depth;
+}
+
+static void _workqueue_stat(struct rt_workqueue *queue,
+                            void (*work_func)(struct rt_work *work, void *work_data),
+                            rt_tick_t wait, rt_tick_t exec)
+{
+    rt_uint8_t index;
+    rt_base_t level;
+    struct rt_work_stat *stat;
+
+    level = rt_hw_interrupt_disable();
+    for (index = 0; index < RT_WORKQUEUE_STAT_MAX; index ++)
+    {
+        stat = &(queue->stat[index]);
+        if (stat->work_func == work_func || stat->work_func == RT_NULL)
+        {
+            stat->work_func = work_func;
+            stat->count ++;
+            stat->wait_total += wait;
+            stat->exec_total += exec;
+            if (wait > stat->wait_max) stat->wait_max = wait;
+            if (exec > stat->exec_max) stat->exec_max = exec;
+            break;
+        }
+    }
+    if (index == RT_WORKQUEUE_STAT_MAX)
+        queue->stat_missed ++;
+    rt_hw_interrupt_enable(level);
+}
+
 static void _workqueue_thread_entry(void *parameter)
 {
     rt_base_t level;
     struct rt_work *work;
     struct rt_workqueue *queue;
+    struct rt_workqueue_worker *worker;
+    void (*work_func)(struct rt_work *work, void *work_data);
+    rt_tick_t wait, start;
 
-    queue = (struct rt_workqueue *) parameter;
-    RT_ASSERT(queue != RT_NULL);
+    worker = (struct rt_workqueue_worker *) parameter;
+    RT_ASSERT(worker != RT_NULL);
+    queue = worker->queue;
 
     while (1)
     {
+        /* one count for every submitted work */
+        rt_sem_take(&(queue->work_sem), RT_WAITING_FOREVER);
+
+        level = rt_hw_interrupt_disable();
         if (rt_list_isempty(&(queue->work_list)))
         {
-            /* no software timer exist, suspend self. */
-            rt_thread_suspend(rt_thread_self());
-            rt_schedule();
+            /* the work has been cancelled or taken by another worker */
+            rt_hw_interrupt_enable(level);
+            continue;
         }
 
         /* we have work to do with. */
-        level = rt_hw_interrupt_disable();
         work = rt_list_entry(queue->work_list.next, struct rt_work, list);
-        rt_list_remove(&(work->list));
-        queue->work_current = work;
+        _workqueue_unlink(queue, work);
+        worker->work_current = work;
         work->flags &= ~RT_WORK_STATE_PENDING;
+        work_func = work->work_func;
+        wait = rt_tick_get() - work->submit_tick;
         rt_hw_interrupt_enable(level);
 
         /* do work */
-        work->work_func(work, work->work_data);
+        start = rt_tick_get();
+        work_func(work, work->work_data);
+        _workqueue_stat(queue, work_func, wait, rt_tick_get() - start);
+
         level = rt_hw_interrupt_disable();
         /* clean current work */
-        queue->work_current = RT_NULL;
+        worker->work_current = RT_NULL;
         rt_hw_interrupt_enable(level);
 
         /* ack work completion */
@@ -96,30 +193,18 @@ static rt_err_t _workqueue_submit_work(struct rt_workqueue *queue, struct rt_wor
         return -RT_EBUSY;
     }
 
-    if (queue->work_current == work)
+    if (_workqueue_is_current(queue, work))
     {
         rt_hw_interrupt_enable(level);
         return -RT_EBUSY;
     }
 
-    /* NOTE: the work MUST be initialized firstly */
-    rt_list_remove(&(work->list));
-
-    rt_list_insert_after(queue->work_list.prev, &(work->list));
+    _workqueue_enqueue(queue, work);
     work->flags |= RT_WORK_STATE_PENDING;
+    rt_hw_interrupt_enable(level);
 
-    /* whether the workqueue is doing work */
-    if (queue->work_current == RT_NULL)
-    {
-        rt_hw_interrupt_enable(level);
-        /* resume work thread */
-        rt_thread_resume(queue->work_thread);
-        rt_schedule();
-    }
-    else
-    {
-        rt_hw_interrupt_enable(level);
-    }
+    /* wake up a worker */
+    rt_sem_release(&(queue->work_sem));
 
     return RT_EOK;
 }
@@ -129,49 +214,141 @@ static rt_err_t _workqueue_cancel_work(struct rt_workqueue *queue, struct rt_wor
     rt_base_t level;
 
     level = rt_hw_interrupt_disable();
-    if (queue->work_current == work)
+    if (_workqueue_is_current(queue, work))
     {
         rt_hw_interrupt_enable(level);
         return -RT_EBUSY;
     }
-    rt_list_remove(&(work->list));
+    _workqueue_unlink(queue, work);
     work->flags &= ~RT_WORK_STATE_PENDING;
     rt_hw_interrupt_enable(level);
 
     return RT_EOK;
 }
 
+/*
+ * The delayed work of a queue is kept in a binary min-heap ordered by timeout
+ * tick, and one timer is always armed for the root of the heap. Every delayed
+ * work knows its position in the heap, so it can be cancelled in O(log n).
+ * The heap is allocated with the queue and never grows, so delayed work can
+ * be submitted from interrupt context.
+ * interrupt shall be disabled for all heap operations
+ */
+rt_inline rt_bool_t _delayed_work_before(struct rt_delayed_work *a, struct rt_delayed_work *b)
+{
+    return (rt_int32_t)(a->timeout_tick - b->timeout_tick) < 0;
+}
+
+rt_inline void _delayed_heap_set(struct rt_workqueue *queue, rt_uint32_t index, struct rt_delayed_work *work)
+{
+    queue->delayed_heap[index] = work;
+    work->heap_index = index;
+}
+
+static void _delayed_heap_up(struct rt_workqueue *queue, rt_uint32_t index)
+{
+    rt_uint32_t parent;
+    struct rt_delayed_work *work = queue->delayed_heap[index];
+
+    while (index > 0)
+    {
+        parent = (index - 1) / 2;
+        if (!_delayed_work_before(work, queue->delayed_heap[parent]))
+            break;
+
+        _delayed_heap_set(queue, index, queue->delayed_heap[parent]);
+        index = parent;
+    }
+    _delayed_heap_set(queue, index, work);
+}
+
+static void _delayed_heap_down(struct rt_workqueue *queue, rt_uint32_t index)
+{
+    rt_uint32_t child;
+    struct rt_delayed_work *work = queue->delayed_heap[index];
+
+    while (1)
+    {
+        child = index * 2 + 1;
+        if (child >= queue->delayed_num)
+            break;
+
+        if (child + 1 < queue->delayed_num &&
+                _delayed_work_before(queue->delayed_heap[child + 1], queue->delayed_heap[child]))
+            child ++;
+        if (!_delayed_work_before(queue->delayed_heap[child], work))
+            break;
+
+        _delayed_heap_set(queue, index, queue->delayed_heap[child]);
+        index = child;
+    }
+    _delayed_heap_set(queue, index, work);
+}
+
+static void _delayed_heap_remove(struct rt_workqueue *queue, struct rt_delayed_work *work)
+{
+    rt_uint32_t index = work->heap_index;
+    struct rt_delayed_work *last;
+
+    last = queue->delayed_heap[-- queue->delayed_num];
+    if (index < queue->delayed_num)
+    {
+        _delayed_heap_set(queue, index, last);
+        _delayed_heap_up(queue, index);
+        _delayed_heap_down(queue, last->heap_index);
+    }
+}
+
+static void _delayed_timer_arm(struct rt_workqueue *queue)
+{
+    rt_tick_t ticks;
+
+    rt_timer_stop(&(queue->delayed_timer));
+    if (queue->delayed_num == 0)
+        return;
+
+    ticks = queue->delayed_heap[0]->timeout_tick - rt_tick_get();
+    if ((rt_int32_t)ticks <= 0)
+        ticks = 1;
+
+    rt_timer_control(&(queue->delayed_timer), RT_TIMER_CTRL_SET_TIME, &ticks);
+    rt_timer_start(&(queue->delayed_timer));
+}
+
 static rt_err_t _workqueue_cancel_delayed_work(struct rt_delayed_work *work)
 {
     rt_base_t level;
     int ret = RT_EOK;
+    struct rt_workqueue *queue = work->workqueue;
 
-    if (!work->workqueue)
+    if (!queue)
     {
         ret = -EINVAL;
         goto __exit;
     }
 
+    level = rt_hw_interrupt_disable();
+    if (work->work.flags & RT_WORK_STATE_SUBMITTING)
+    {
+        /* still waiting for its timeout */
+        rt_bool_t is_root = (queue->delayed_heap[0] == work);
+
+        _delayed_heap_remove(queue, work);
+        work->work.flags &= ~RT_WORK_STATE_SUBMITTING;
+        if (is_root)
+            _delayed_timer_arm(queue);
+    }
+    rt_hw_interrupt_enable(level);
+
     if (work->work.flags & RT_WORK_STATE_PENDING)
     {
         /* Remove from the queue if already submitted */
-        ret = rt_workqueue_cancel_work(work->workqueue, &(work->work));
+        ret = _workqueue_cancel_work(queue, &(work->work));
         if (ret)
         {
             goto __exit;
         }
     }
-    else
-    {
-        if (work->work.flags & RT_WORK_STATE_SUBMITTING)
-        {
-            level = rt_hw_interrupt_disable();
-            rt_timer_stop(&(work->timer));
-            rt_timer_detach(&(work->timer));
-            work->work.flags &= ~RT_WORK_STATE_SUBMITTING;
-            rt_hw_interrupt_enable(level);
-        }
-    }
 
     level = rt_hw_interrupt_disable();
     /* Detach from workqueue */
@@ -207,25 +384,36 @@ static rt_err_t _workqueue_submit_delayed_work(struct rt_workqueue *queue,
         }
     }
 
-    level = rt_hw_interrupt_disable();
-    /* Attach workqueue so the timeout callback can submit it */
-    work->workqueue = queue;
-    rt_hw_interrupt_enable(level);
-
     if (!ticks)
     {
+        level = rt_hw_interrupt_disable();
+        /* Attach workqueue so the work can be cancelled */
+        work->workqueue = queue;
+        rt_hw_interrupt_enable(level);
+
         /* Submit work if no ticks is 0 */
         _workqueue_submit_work(work->workqueue, &(work->work));
     }
     else
     {
         level = rt_hw_interrupt_disable();
-        /* Add timeout */
+        if (queue->delayed_num == RT_WORKQUEUE_DELAYED_MAX)
+        {
+            rt_hw_interrupt_enable(level);
+            ret = -RT_EFULL;
+            goto __exit;
+        }
+
+        /* Attach workqueue so the timeout callback can submit it */
+        work->workqueue = queue;
+        work->timeout_tick = rt_tick_get() + ticks;
         work->work.flags |= RT_WORK_STATE_SUBMITTING;
-        rt_timer_init(&(work->timer), "work", _delayed_work_timeout_handler, work, ticks,
-                      RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_SOFT_TIMER);
+
+        _delayed_heap_set(queue, queue->delayed_num ++, work);
+        _delayed_heap_up(queue, work->heap_index);
+        if (queue->delayed_heap[0] == work)
+            _delayed_timer_arm(queue);
         rt_hw_interrupt_enable(level);
-        rt_timer_start(&(work->timer));
     }
 
 __exit:
@@ -234,49 +422,128 @@ __exit:
 
 static void _delayed_work_timeout_handler(void *parameter)
 {
-    struct rt_delayed_work *delayed_work;
+    struct rt_workqueue *queue;
+    struct rt_delayed_work *work;
     rt_base_t level;
 
-    delayed_work = (struct rt_delayed_work *)parameter;
+    queue = (struct rt_workqueue *)parameter;
+
     level = rt_hw_interrupt_disable();
-    rt_timer_stop(&(delayed_work->timer));
-    rt_timer_detach(&(delayed_work->timer));
-    delayed_work->work.flags &= ~RT_WORK_STATE_SUBMITTING;
+    while (queue->delayed_num > 0)
+    {
+        work = queue->delayed_heap[0];
+        if ((rt_int32_t)(rt_tick_get() - work->timeout_tick) < 0)
+            break;
+
+        _delayed_heap_remove(queue, work);
+        work->work.flags &= ~RT_WORK_STATE_SUBMITTING;
+        rt_hw_interrupt_enable(level);
+
+        _workqueue_submit_work(queue, &(work->work));
+
+        level = rt_hw_interrupt_disable();
+    }
+
+    /* arm for the next one; the periodic timer keeps it running, or stops */
+    _delayed_timer_arm(queue);
     rt_hw_interrupt_enable(level);
-    _workqueue_submit_work(delayed_work->workqueue, &(delayed_work->work));
 }
 
-struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority)
+struct rt_workqueue *rt_workqueue_create_workers(const char *name, rt_uint16_t stack_size, rt_uint8_t priority,
+                                                 rt_uint8_t worker_num)
 {
+    rt_uint8_t index;
+    rt_base_t level;
     struct rt_workqueue *queue = RT_NULL;
+    char thread_name[RT_NAME_MAX];
+
+    RT_ASSERT(worker_num > 0);
 
-    queue = (struct rt_workqueue *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue));
+    /* the workers and the delayed heap follow the queue */
+    queue = (struct rt_workqueue *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue) +
+                                                   worker_num * sizeof(struct rt_workqueue_worker) +
+                                                   RT_WORKQUEUE_DELAYED_MAX * sizeof(struct rt_delayed_work *));
     if (queue != RT_NULL)
     {
+        rt_memset(queue, 0, sizeof(struct rt_workqueue));
+        rt_list_init(&(queue->list));
+
         /* initialize work list */
         rt_list_init(&(queue->work_list));
-        queue->work_current = RT_NULL;
         rt_sem_init(&(queue->sem), "wqueue", 0, RT_IPC_FLAG_FIFO);
+        rt_sem_init(&(queue->work_sem), "wqwork", 0, RT_IPC_FLAG_FIFO);
+
+        /*
+         * the timer is re-armed from its own timeout function for the next
+         * delayed work; a periodic timer keeps that re-arming in effect
+         */
+        rt_timer_init(&(queue->delayed_timer), "wqdelay", _delayed_work_timeout_handler, queue, 1,
+                      RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_SOFT_TIMER);
 
-        /* create the work thread */
-        queue->work_thread = rt_thread_create(name, _workqueue_thread_entry, queue, stack_size, priority, 10);
-        if (queue->work_thread == RT_NULL)
+        queue->workers = (struct rt_workqueue_worker *)(queue + 1);
+        queue->delayed_heap = (struct rt_delayed_work **)(queue->workers + worker_num);
+
+        /* create the work threads, the first one with the name of the queue */
+        for (index = 0; index < worker_num; index ++)
+        {
+            if (index == 0)
+                rt_strncpy(thread_name, name, RT_NAME_MAX);
+            else
+                rt_snprintf(thread_name, RT_NAME_MAX, "%.*s%d", RT_NAME_MAX - 3, name, index);
+
+            queue->workers[index].queue = queue;
+            queue->workers[index].work_current = RT_NULL;
+            queue->workers[index].thread = rt_thread_create(thread_name, _workqueue_thread_entry,
+                                                            &(queue->workers[index]),
+                                                            stack_size, priority, 10);
+            if (queue->workers[index].thread == RT_NULL)
+            {
+                queue->worker_num = index;
+                rt_workqueue_destroy(queue);
+                return RT_NULL;
+            }
+        }
+        queue->worker_num = worker_num;
+
+        for (index = 0; index < worker_num; index ++)
         {
-            RT_KERNEL_FREE(queue);
-            return RT_NULL;
+            rt_thread_startup(queue->workers[index].thread);
         }
 
-        rt_thread_startup(queue->work_thread);
+        level = rt_hw_interrupt_disable();
+        rt_list_insert_before(&_workqueue_list, &(queue->list));
+        rt_hw_interrupt_enable(level);
     }
 
     return queue;
 }
 
+struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority)
+{
+    return rt_workqueue_create_workers(name, stack_size, priority, 1);
+}
+
 rt_err_t rt_workqueue_destroy(struct rt_workqueue *queue)
 {
+    rt_uint8_t index;
+    rt_base_t level;
+
     RT_ASSERT(queue != RT_NULL);
 
-    rt_thread_delete(queue->work_thread);
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&(queue->list));
+    rt_hw_interrupt_enable(level);
+
+    rt_timer_stop(&(queue->delayed_timer));
+    rt_timer_detach(&(queue->delayed_timer));
+
+    for (index = 0; index < queue->worker_num; index ++)
+    {
+        rt_thread_delete(queue->workers[index].thread);
+    }
+
+    rt_sem_detach(&(queue->work_sem));
+    rt_sem_detach(&(queue->sem));
     RT_KERNEL_FREE(queue);
 
     return RT_EOK;
@@ -312,24 +579,17 @@ rt_err_t rt_workqueue_critical_work(struct rt_workqueue *queue, struct rt_work *
     RT_ASSERT(work != RT_NULL);
 
     level = rt_hw_interrupt_disable();
-    if (queue->work_current == work)
+    if (_workqueue_is_current(queue, work))
     {
         rt_hw_interrupt_enable(level);
         return -RT_EBUSY;
     }
 
-    /* NOTE: the work MUST be initialized firstly */
-    rt_list_remove(&(work->list));
+    _workqueue_enqueue(queue, work);
+    rt_hw_interrupt_enable(level);
 
-    rt_list_insert_after(queue->work_list.prev, &(work->list));
-    if (queue->work_current == RT_NULL)
-    {
-        rt_hw_interrupt_enable(level);
-        /* resume work thread */
-        rt_thread_resume(queue->work_thread);
-        rt_schedule();
-    }
-    else rt_hw_interrupt_enable(level);
+    /* wake up a worker */
+    rt_sem_release(&(queue->work_sem));
 
     return RT_EOK;
 }
@@ -357,15 +617,14 @@ rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_wor
     RT_ASSERT(work != RT_NULL);
 
     level = rt_hw_interrupt_disable();
-    if (queue->work_current == work) /* it's current work in the queue */
+    while (_workqueue_is_current(queue, work)) /* it's current work of a worker */
     {
+        rt_hw_interrupt_enable(level);
         /* wait for work completion */
         rt_sem_take(&(queue->sem), RT_WAITING_FOREVER);
+        level = rt_hw_interrupt_disable();
     }
-    else
-    {
-        rt_list_remove(&(work->list));
-    }
+    _workqueue_unlink(queue, work);
     work->flags &= ~RT_WORK_STATE_PENDING;
     rt_hw_interrupt_enable(level);
 
@@ -382,7 +641,9 @@ rt_err_t rt_workqueue_cancel_all_work(struct rt_workqueue *queue)
     {
         next = node->next;
         rt_list_remove(node);
+        rt_list_entry(node, struct rt_work, list)->flags &= ~RT_WORK_STATE_PENDING;
     }
+    queue->depth = 0;
     rt_exit_critical();
 
     return RT_EOK;
@@ -393,6 +654,7 @@ void rt_delayed_work_init(struct rt_delayed_work *work, void (*work_func)(struct
 {
     rt_work_init(&(work->work), work_func, work_data);
     work->work.type = RT_WORK_TYPE_DELAYED;
+    work->workqueue = RT_NULL;
 }
 
 #ifdef RT_USING_SYSTEM_WORKQUEUE
@@ -410,12 +672,49 @@ rt_err_t rt_work_cancel(struct rt_work *work)
 
 static int rt_work_sys_workqueue_init(void)
 {
-    sys_workq = rt_workqueue_create("sys_work", RT_SYSTEM_WORKQUEUE_STACKSIZE,
-                                    RT_SYSTEM_WORKQUEUE_PRIORITY);
+    sys_workq = rt_workqueue_create_workers("sys_work", RT_SYSTEM_WORKQUEUE_STACKSIZE,
+                                            RT_SYSTEM_WORKQUEUE_PRIORITY,
+                                            RT_SYSTEM_WORKQUEUE_WORKERS);
 
     return RT_EOK;
 }
 
 INIT_DEVICE_EXPORT(rt_work_sys_workqueue_init);
 #endif
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+static void list_workqueue(void)
+{
+    rt_uint8_t index;
+    struct rt_list_node *node;
+    struct rt_workqueue *queue;
+    struct rt_work_stat *stat;
+
+    rt_enter_critical();
+    rt_list_for_each(node, &_workqueue_list)
+    {
+        queue = rt_list_entry(node, struct rt_workqueue, list);
+
+        rt_kprintf("%-*.*s workers %d, depth %d (max %d), delayed %d/%d, unaccounted %d\n",
+                   RT_NAME_MAX, RT_NAME_MAX, queue->workers[0].thread->name,
+                   queue->worker_num, queue->depth, queue->depth_max,
+                   queue->delayed_num, RT_WORKQUEUE_DELAYED_MAX, queue->stat_missed);
+        rt_kprintf(" function   count      wait avg/max(tick) exec avg/max(tick)\n");
+        for (index = 0; index < RT_WORKQUEUE_STAT_MAX; index ++)
+        {
+            stat = &(queue->stat[index]);
+            if (stat->work_func == RT_NULL)
+                break;
+
+            rt_kprintf(" 0x%08x %-10d %8d/%-9d %8d/%d\n", stat->work_func, stat->count,
+                       stat->wait_total / stat->count, stat->wait_max,
+                       stat->exec_total / stat->count, stat->exec_max);
+        }
+    }
+    rt_exit_critical();
+}
+MSH_CMD_EXPORT(list_workqueue, list workqueues and work statistics);
+#endif
+
 #endif
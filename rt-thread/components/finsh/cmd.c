@@ -268,7 +268,7 @@ static long _list_mutex(struct rt_list_node *list)
                    maxlen, RT_NAME_MAX,
                    m->parent.parent.name,
                    RT_NAME_MAX,
-                   m->owner->name,
+                   RT_MUTEX_OWNER(m)->name,
                    m->hold,
                    rt_list_len(&m->parent.suspend_thread));
     }
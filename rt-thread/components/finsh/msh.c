@@ -8,6 +8,7 @@
  * 2013-03-30     Bernard      the first verion for finsh
  * 2014-01-03     Bernard      msh can execute module.
  * 2017-07-19     Aubr.Cool    limit argc to RT_FINSH_ARG_MAX
+ * 2026-10-19     yqiu         add the sorted command index and the batch mode.
  */
 #include <rtthread.h>
 
@@ -29,8 +30,65 @@
 #define FINSH_ARG_MAX    8
 #endif
 
+#ifndef FINSH_CMD_INDEX_MAX
+#define FINSH_CMD_INDEX_MAX    128
+#endif
+
 typedef int (*cmd_function_t)(int argc, char **argv);
 
+/* the commands sorted by name, none when there are more than it holds */
+static struct finsh_syscall *msh_cmd_index[FINSH_CMD_INDEX_MAX];
+static int msh_cmd_num;
+
+/**
+ * This function sorts the commands of the symbol table into the command
+ * index, it shall be called after finsh_system_function_init.
+ */
+void msh_cmd_index_init(void)
+{
+    struct finsh_syscall *index;
+    int num = 0, pos;
+
+    msh_cmd_num = 0;
+    for (index = _syscall_table_begin;
+            index < _syscall_table_end;
+            FINSH_NEXT_SYSCALL(index))
+    {
+        if (strncmp(index->name, "__cmd_", 6) != 0) continue;
+
+        if (num == FINSH_CMD_INDEX_MAX)
+        {
+            rt_kprintf("msh: more than %d commands, searching without the index.\n", FINSH_CMD_INDEX_MAX);
+            return;
+        }
+
+        /* insertion sort, the first exported of the same name stays first */
+        for (pos = num; pos > 0 && strcmp(&msh_cmd_index[pos - 1]->name[6], &index->name[6]) > 0; pos --)
+            msh_cmd_index[pos] = msh_cmd_index[pos - 1];
+        msh_cmd_index[pos] = index;
+        num ++;
+    }
+
+    msh_cmd_num = num;
+}
+
+/* the position of the first command not below the prefix of size characters */
+static int msh_cmd_lower_bound(const char *prefix, rt_size_t size)
+{
+    int low = 0, high = msh_cmd_num, mid;
+
+    while (low < high)
+    {
+        mid = (low + high) / 2;
+        if (strncmp(&msh_cmd_index[mid]->name[6], prefix, size) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
 #ifdef FINSH_USING_MSH
 #ifdef FINSH_USING_MSH_ONLY
 rt_bool_t msh_is_used(void)
@@ -65,9 +123,26 @@ static int msh_enter(void)
 FINSH_FUNCTION_EXPORT_ALIAS(msh_enter, msh, use module shell);
 #endif
 
+static void msh_help_show(struct finsh_syscall *index)
+{
+#if defined(FINSH_USING_DESCRIPTION) && defined(FINSH_USING_SYMTAB)
+    rt_kprintf("%-16s - %s\n", &index->name[6], index->desc);
+#else
+    rt_kprintf("%s ", &index->name[6]);
+#endif
+}
+
 int msh_help(int argc, char **argv)
 {
     rt_kprintf("RT-Thread shell commands:\n");
+    if (msh_cmd_num)
+    {
+        int pos;
+
+        for (pos = 0; pos < msh_cmd_num; pos ++)
+            msh_help_show(msh_cmd_index[pos]);
+    }
+    else
     {
         struct finsh_syscall *index;
 
@@ -76,11 +151,7 @@ int msh_help(int argc, char **argv)
                 FINSH_NEXT_SYSCALL(index))
         {
             if (strncmp(index->name, "__cmd_", 6) != 0) continue;
-#if defined(FINSH_USING_DESCRIPTION) && defined(FINSH_USING_SYMTAB)
-            rt_kprintf("%-16s - %s\n", &index->name[6], index->desc);
-#else
-            rt_kprintf("%s ", &index->name[6]);
-#endif
+            msh_help_show(index);
         }
     }
     rt_kprintf("\n");
@@ -164,6 +235,22 @@ static cmd_function_t msh_get_cmd(char *cmd, int size)
     struct finsh_syscall *index;
     cmd_function_t cmd_func = RT_NULL;
 
+    if (msh_cmd_num)
+    {
+        int pos;
+
+        /* the exact name sorts before the longer ones it prefixes */
+        pos = msh_cmd_lower_bound(cmd, size);
+        if (pos < msh_cmd_num)
+        {
+            index = msh_cmd_index[pos];
+            if (strncmp(&index->name[6], cmd, size) == 0 && index->name[6 + size] == '\0')
+                cmd_func = (cmd_function_t)index->func;
+        }
+
+        return cmd_func;
+    }
+
     for (index = _syscall_table_begin;
             index < _syscall_table_end;
             FINSH_NEXT_SYSCALL(index))
@@ -256,11 +343,21 @@ int msh_exec_module(const char *cmd_line, int size)
 int system(const char *command)
 {
     int ret = -RT_ENOMEM;
-    char *cmd = rt_strdup(command);
+    char line[FINSH_CMD_SIZE];
+    rt_size_t length = rt_strlen(command);
+    char *cmd;
 
+    /* a command as long as a shell line is split on the stack */
+    if (length < sizeof(line))
+    {
+        rt_memcpy(line, command, length + 1);
+        return msh_exec(line, length);
+    }
+
+    cmd = rt_strdup(command);
     if (cmd)
     {
-        ret = msh_exec(cmd, rt_strlen(cmd));
+        ret = msh_exec(cmd, length);
         rt_free(cmd);
     }
 
@@ -397,6 +494,45 @@ int msh_exec(char *cmd, rt_size_t length)
     return -1;
 }
 
+/**
+ * This function runs the lines of a script as commands, without prompt and
+ * echo. The empty lines and the lines starting with '#' are skipped.
+ *
+ * @param script the script, it is split in place and script[length] is set
+ *        to '\0', so the buffer holds length + 1 characters at least
+ * @param length the length of the script
+ *
+ * @return the number of commands which failed or were not found
+ */
+int msh_exec_batch(char *script, rt_size_t length)
+{
+    char *line, *end = script + length;
+    rt_size_t size;
+    int failed = 0;
+
+    *end = '\0';
+    for (line = script; line < end; line += size + 1)
+    {
+        for (size = 0; line + size < end && line[size] != '\n'; size ++);
+        line[size] = '\0';
+        if (size && line[size - 1] == '\r')
+            line[size - 1] = '\0';
+
+        while (*line == ' ' || *line == '\t')
+        {
+            line ++;
+            size --;
+        }
+        if (*line == '\0' || *line == '#')
+            continue;
+
+        if (msh_exec(line, rt_strlen(line)) != 0)
+            failed ++;
+    }
+
+    return failed;
+}
+
 static int str_common(const char *str1, const char *str2)
 {
     const char *str = str1;
@@ -533,9 +669,29 @@ void msh_auto_complete_path(char *path)
 }
 #endif
 
+/* list a command matching the prefix, keep the part common to all matches */
+static void msh_auto_complete_match(const char *cmd_name, const char **name_ptr, int *min_length)
+{
+    int length;
+
+    if (*min_length == 0)
+    {
+        /* set name_ptr */
+        *name_ptr = cmd_name;
+        /* set initial length */
+        *min_length = strlen(*name_ptr);
+    }
+
+    length = str_common(*name_ptr, cmd_name);
+    if (length < *min_length)
+        *min_length = length;
+
+    rt_kprintf("%s\n", cmd_name);
+}
+
 void msh_auto_complete(char *prefix)
 {
-    int length, min_length;
+    int min_length;
     const char *name_ptr, *cmd_name;
     struct finsh_syscall *index;
 
@@ -577,6 +733,19 @@ void msh_auto_complete(char *prefix)
 #endif
 
     /* checks in internal command */
+    if (msh_cmd_num)
+    {
+        int pos, size = strlen(prefix);
+
+        /* the matches are in a row in the index */
+        for (pos = msh_cmd_lower_bound(prefix, size);
+                pos < msh_cmd_num && strncmp(&msh_cmd_index[pos]->name[6], prefix, size) == 0;
+                pos ++)
+        {
+            msh_auto_complete_match(&msh_cmd_index[pos]->name[6], &name_ptr, &min_length);
+        }
+    }
+    else
     {
         for (index = _syscall_table_begin; index < _syscall_table_end; FINSH_NEXT_SYSCALL(index))
         {
@@ -585,21 +754,7 @@ void msh_auto_complete(char *prefix)
 
             cmd_name = (const char *) &index->name[6];
             if (strncmp(prefix, cmd_name, strlen(prefix)) == 0)
-            {
-                if (min_length == 0)
-                {
-                    /* set name_ptr */
-                    name_ptr = cmd_name;
-                    /* set initial length */
-                    min_length = strlen(name_ptr);
-                }
-
-                length = str_common(name_ptr, cmd_name);
-                if (length < min_length)
-                    min_length = length;
-
-                rt_kprintf("%s\n", cmd_name);
-            }
+                msh_auto_complete_match(cmd_name, &name_ptr, &min_length);
         }
     }
 
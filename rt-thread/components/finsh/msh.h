@@ -15,7 +15,9 @@
 
 rt_bool_t msh_is_used(void);
 int msh_exec(char *cmd, rt_size_t length);
+int msh_exec_batch(char *script, rt_size_t length);
 void msh_auto_complete(char *prefix);
+void msh_cmd_index_init(void);
 
 int msh_exec_module(const char *cmd_line, int size);
 int msh_exec_script(const char *cmd_line, int size);
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2015-09-25     Bernard      the first verion for FinSH
+ * 2026-10-19     yqiu         read scripts in blocks, add the batch command.
  */
 
 #include <rtthread.h>
@@ -13,47 +14,65 @@
 #if defined(FINSH_USING_MSH) && defined(RT_USING_DFS)
 
 #include <finsh.h>
+#include <shell.h>
 #include "msh.h"
 #include <dfs_posix.h>
 
-static int msh_readline(int fd, char *line_buf, int size)
+#define MSH_BATCH_BUF_SIZE     (FINSH_CMD_SIZE * 4)
+
+/* run the lines of a file, read in blocks; a longer line is skipped and counts as failed */
+static int msh_exec_fd(int fd)
 {
-    char ch;
-    int index = 0;
+    char *buf, *eol, saved;
+    int length = 0, count, used, failed = 0;
+    rt_bool_t skipping = RT_FALSE;
+
+    buf = (char *) rt_malloc(MSH_BATCH_BUF_SIZE + 1);
+    if (buf == RT_NULL) return -RT_ENOMEM;
 
-    do
+    for (;;)
     {
-        if (read(fd, &ch, 1) != 1)
+        count = read(fd, buf + length, MSH_BATCH_BUF_SIZE - length);
+        if (count > 0) length += count;
+
+        /* drop the rest of a long line, up to its newline */
+        if (skipping)
         {
-            /* nothing in this file */
-            return 0;
+            eol = memchr(buf, '\n', length);
+            used = eol ? eol - buf + 1 : length;
+            skipping = (eol == RT_NULL);
+
+            length -= used;
+            memmove(buf, buf + used, length);
         }
-    }
-    while (ch == '\n' || ch == '\r');
 
-    /* set the first character */
-    line_buf[index ++] = ch;
+        /* the complete lines, or the last line at the end of file */
+        for (used = length; used > 0 && buf[used - 1] != '\n'; used --);
+        if (count <= 0)
+            used = length;
 
-    while (index < size)
-    {
-        if (read(fd, &ch, 1) == 1)
+        if (used)
         {
-            if (ch == '\n' || ch == '\r')
-            {
-                line_buf[index] = '\0';
-                break;
-            }
+            saved = buf[used];
+            failed += msh_exec_batch(buf, used);
+            buf[used] = saved;
 
-            line_buf[index++] = ch;
+            length -= used;
+            memmove(buf, buf + used, length);
         }
-        else
+        else if (length == MSH_BATCH_BUF_SIZE)
         {
-            line_buf[index] = '\0';
-            break;
+            rt_kprintf("msh: line too long, at most %d characters, skipped\n", MSH_BATCH_BUF_SIZE - 1);
+            failed ++;
+            skipping = RT_TRUE;
+            length = 0;
         }
+
+        if (count <= 0) break;
     }
 
-    return index;
+    rt_free(buf);
+    return failed;
 }
 
 int msh_exec_script(const char *cmd_line, int size)
@@ -97,35 +116,8 @@ int msh_exec_script(const char *cmd_line, int size)
     if (fd >= 0)
     {
         /* found script */
-        char *line_buf;
-        int length;
-
-        line_buf = (char *) rt_malloc(RT_CONSOLEBUF_SIZE);
-
-        /* read line by line and then exec it */
-        do
-        {
-            length = msh_readline(fd, line_buf, RT_CONSOLEBUF_SIZE);
-            if (length > 0)
-            {
-                char ch = '\0';
-                int index;
-
-                for (index = 0; index < length; index ++)
-                {
-                    ch = line_buf[index];
-                    if (ch == ' ' || ch == '\t') continue;
-                    else break;
-                }
-
-                if (ch != '#') /* not a comment */
-                    msh_exec(line_buf, length);
-            }
-        }
-        while (length > 0);
-
+        msh_exec_fd(fd);
         close(fd);
-        rt_free(line_buf);
 
         ret = 0;
     }
@@ -137,5 +129,32 @@ int msh_exec_script(const char *cmd_line, int size)
     return ret;
 }
 
+static int cmd_batch(int argc, char **argv)
+{
+    int fd, failed;
+
+    if (argc != 2)
+    {
+        rt_kprintf("Usage: batch FILE\n");
+        return -1;
+    }
+
+    fd = open(argv[1], O_RDONLY, 0);
+    if (fd < 0)
+    {
+        rt_kprintf("batch: open %s failed\n", argv[1]);
+        return -1;
+    }
+
+    failed = msh_exec_fd(fd);
+    close(fd);
+
+    if (failed)
+        rt_kprintf("batch: %d commands failed\n", failed);
+
+    return failed;
+}
+FINSH_FUNCTION_EXPORT_ALIAS(cmd_batch, __cmd_batch, Run the commands of a FILE without prompt and echo.);
+
 #endif /* defined(FINSH_USING_MSH) && defined(RT_USING_DFS) */
 
@@ -828,6 +828,10 @@ int finsh_system_init(void)
 #endif
 #endif
 
+#ifdef FINSH_USING_MSH
+    msh_cmd_index_init();
+#endif
+
 #ifdef RT_USING_HEAP
     /* create or set shell structure */
     shell = (struct finsh_shell *)rt_calloc(1, sizeof(struct finsh_shell));
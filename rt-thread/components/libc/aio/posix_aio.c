@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2017/12/30     Bernard      The first version.
+ * 2026-10-19     yqiu         worker pool, batching of adjacent requests,
+ *                             aio_suspend, lio_listio and notification
  */
 
 #include <stdint.h>
@@ -19,8 +21,368 @@
 
 #include "posix_aio.h"
 
+#ifndef RT_POSIX_AIO_WORKERS
+#define RT_POSIX_AIO_WORKERS        2
+#endif
+
+#ifndef RT_POSIX_AIO_BATCH_MAX
+#define RT_POSIX_AIO_BATCH_MAX      8
+#endif
+
+#ifndef RT_POSIX_AIO_MERGE_SIZE
+#define RT_POSIX_AIO_MERGE_SIZE     4096
+#endif
+
+#define AIO_OP_FSYNC                (LIO_NOP + 1)
+
+/*
+ * Requests wait on aio_pending in the order of submission and every
+ * submission kicks a worker of the pool. A kicked worker takes the file
+ * descriptor of the first pending request no other worker has and serves the
+ * pending requests of that file in order, so one file is never read or
+ * written by two workers at once. Consecutive requests of the same operation
+ * on adjacent ranges of the file go in one batch: a single seek and, up to
+ * RT_POSIX_AIO_MERGE_SIZE bytes, a single read or write through a bounce
+ * buffer.
+ */
+struct aio_lio_group
+{
+    int remaining;                      /* guarded by aio_lock */
+    struct sigevent sig;
+    rt_thread_t thread;
+    struct rt_semaphore *done;          /* LIO_WAIT, on the waiting stack */
+};
+
+struct aio_waiter
+{
+    rt_list_t list;
+    struct rt_semaphore sem;
+};
+
 struct rt_workqueue* aio_queue = NULL;
 
+static struct rt_mutex aio_lock;
+static rt_list_t aio_pending;
+static rt_list_t aio_waiters;
+static int aio_busy_fd[RT_POSIX_AIO_WORKERS];
+/* a running kick can not be queued again, one more than workers is never all running */
+static struct rt_work aio_kick[RT_POSIX_AIO_WORKERS + 1];
+
+static int aio_errno(void)
+{
+    int err = rt_get_errno();
+
+    if (err > 0)
+        err = -err;
+
+    return err ? err : -EIO;
+}
+
+#ifdef RT_USING_SIGNALS
+/* the submitter may have exited since, only a thread still alive is signalled */
+static void aio_thread_kill(rt_thread_t thread, int signo)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+
+    rt_enter_critical();
+    information = rt_object_get_information(RT_Object_Class_Thread);
+    RT_ASSERT(information != RT_NULL);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        if (node != &(thread->list))
+            continue;
+
+        if ((thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+            rt_thread_kill(thread, signo);
+        break;
+    }
+    rt_exit_critical();
+}
+#endif
+
+static void aio_notify(const struct sigevent *sig, rt_thread_t thread)
+{
+    switch (sig->sigev_notify)
+    {
+#ifdef RT_USING_SIGNALS
+    case SIGEV_SIGNAL:
+        aio_thread_kill(thread, sig->sigev_signo);
+        break;
+#endif
+    case SIGEV_THREAD:
+        /* called on the worker, there is no thread created for it */
+        if (sig->sigev_notify_function)
+            sig->sigev_notify_function(sig->sigev_value);
+        break;
+    default:
+        break;
+    }
+}
+
+/* the control block may be reused by its owner once aio_result is set */
+static void aio_complete(struct aiocb *cb, int result)
+{
+    struct sigevent sig = cb->aio_sigevent;
+    rt_thread_t thread = cb->aio_thread;
+    struct aio_lio_group *group;
+    rt_list_t *node;
+
+    rt_mutex_take(&aio_lock, RT_WAITING_FOREVER);
+    group = cb->aio_group;
+    cb->aio_group = RT_NULL;
+    cb->aio_result = result;
+    for (node = aio_waiters.next; node != &aio_waiters; node = node->next)
+        rt_sem_release(&rt_list_entry(node, struct aio_waiter, list)->sem);
+    if (group && --group->remaining > 0)
+        group = RT_NULL;
+    rt_mutex_release(&aio_lock);
+
+    aio_notify(&sig, thread);
+
+    if (group)
+    {
+        if (group->done)
+        {
+            rt_sem_release(group->done);
+        }
+        else
+        {
+            aio_notify(&group->sig, group->thread);
+            rt_free(group);
+        }
+    }
+}
+
+/* takes the next batch of fd off the pending list, aio_lock shall be held */
+static int aio_batch_take(int fd, struct aiocb **batch, int *append)
+{
+    struct aiocb *cb, *prev;
+    rt_list_t *node, *next;
+    int num = 0;
+
+    for (node = aio_pending.next; node != &aio_pending; node = next)
+    {
+        next = node->next;
+        cb = rt_list_entry(node, struct aiocb, aio_node);
+        if (cb->aio_fildes != fd)
+            continue;
+
+        if (num > 0)
+        {
+            prev = batch[num - 1];
+            if (num == RT_POSIX_AIO_BATCH_MAX || cb->aio_op != prev->aio_op ||
+                    cb->aio_op == AIO_OP_FSYNC)
+                break;
+            if (!*append && cb->aio_offset != prev->aio_offset + (off_t)prev->aio_nbytes)
+                break;
+        }
+        else
+        {
+            *append = (cb->aio_op == LIO_WRITE) &&
+                      (fcntl(fd, F_GETFL, 0) & O_APPEND);
+        }
+
+        rt_list_remove(&cb->aio_node);
+        batch[num++] = cb;
+        if (cb->aio_op == AIO_OP_FSYNC)
+            break;
+    }
+
+    return num;
+}
+
+static int aio_transfer(struct aiocb *cb, void *buf, size_t nbytes)
+{
+    if (cb->aio_op == LIO_READ)
+        return read(cb->aio_fildes, buf, nbytes);
+
+    return write(cb->aio_fildes, buf, nbytes);
+}
+
+static void aio_batch_run(struct aiocb **batch, int num, int append)
+{
+    struct aiocb *cb = batch[0];
+    size_t total = 0, part;
+    uint8_t *bounce = RT_NULL;
+    int index, len, result;
+
+    if (cb->aio_op == AIO_OP_FSYNC)
+    {
+        aio_complete(cb, fsync(cb->aio_fildes) < 0 ? aio_errno() : 0);
+        return;
+    }
+
+    for (index = 0; index < num; index++)
+        total += batch[index]->aio_nbytes;
+
+    if (!append && lseek(cb->aio_fildes, cb->aio_offset, SEEK_SET) < 0)
+    {
+        result = aio_errno();
+        for (index = 0; index < num; index++)
+            aio_complete(batch[index], result);
+        return;
+    }
+
+    if (num > 1 && total <= RT_POSIX_AIO_MERGE_SIZE)
+        bounce = (uint8_t *)rt_malloc(total);
+
+    if (bounce)
+    {
+        if (cb->aio_op == LIO_WRITE)
+        {
+            for (index = 0, part = 0; index < num; index++)
+            {
+                rt_memcpy(bounce + part, (void *)batch[index]->aio_buf, batch[index]->aio_nbytes);
+                part += batch[index]->aio_nbytes;
+            }
+        }
+
+        len = aio_transfer(cb, bounce, total);
+        result = (len < 0) ? aio_errno() : 0;
+
+        /* a short transfer ends in the request it stopped in */
+        for (index = 0, total = 0; index < num; index++)
+        {
+            cb = batch[index];
+            if (len < 0)
+            {
+                aio_complete(cb, result);
+                continue;
+            }
+
+            part = ((size_t)len > total) ? (size_t)len - total : 0;
+            if (part > cb->aio_nbytes)
+                part = cb->aio_nbytes;
+            if (cb->aio_op == LIO_READ)
+                rt_memcpy((void *)cb->aio_buf, bounce + total, part);
+            total += cb->aio_nbytes;
+            aio_complete(cb, part);
+        }
+        rt_free(bounce);
+    }
+    else
+    {
+        for (index = 0; index < num; index++)
+        {
+            cb = batch[index];
+            len = aio_transfer(cb, (void *)cb->aio_buf, cb->aio_nbytes);
+            aio_complete(cb, (len < 0) ? aio_errno() : len);
+
+            /* the next one starts where this one ended unless it was short */
+            if (len != (int)cb->aio_nbytes && index + 1 < num && !append)
+                lseek(cb->aio_fildes, batch[index + 1]->aio_offset, SEEK_SET);
+        }
+    }
+}
+
+static rt_bool_t aio_fd_busy(int fd)
+{
+    int slot;
+
+    for (slot = 0; slot < RT_POSIX_AIO_WORKERS; slot++)
+    {
+        if (aio_busy_fd[slot] == fd)
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/* the file of the first pending request no worker has, aio_lock shall be held */
+static int aio_idle_fd(void)
+{
+    rt_list_t *node;
+    int fd;
+
+    for (node = aio_pending.next; node != &aio_pending; node = node->next)
+    {
+        fd = rt_list_entry(node, struct aiocb, aio_node)->aio_fildes;
+        if (!aio_fd_busy(fd))
+            return fd;
+    }
+
+    return -1;
+}
+
+static void aio_work(struct rt_work *work, void *work_data)
+{
+    struct aiocb *batch[RT_POSIX_AIO_BATCH_MAX];
+    int slot, num, append, fd;
+
+    rt_mutex_take(&aio_lock, RT_WAITING_FOREVER);
+    while ((fd = aio_idle_fd()) >= 0)
+    {
+        /* a worker runs one kick at a time, so a slot is free */
+        for (slot = 0; slot < RT_POSIX_AIO_WORKERS - 1 && aio_busy_fd[slot] >= 0; slot++);
+        aio_busy_fd[slot] = fd;
+
+        while ((num = aio_batch_take(fd, batch, &append)) > 0)
+        {
+            rt_mutex_release(&aio_lock);
+            aio_batch_run(batch, num, append);
+            rt_mutex_take(&aio_lock, RT_WAITING_FOREVER);
+        }
+
+        aio_busy_fd[slot] = -1;
+    }
+    rt_mutex_release(&aio_lock);
+}
+
+static int aio_check(struct aiocb *cb, int op)
+{
+    int oflags;
+
+    if (!cb) return -EINVAL;
+
+    oflags = fcntl(cb->aio_fildes, F_GETFL, 0);
+    if (oflags < 0) return -EBADF;
+
+    switch (op)
+    {
+    case LIO_READ:
+        if (cb->aio_buf == NULL) return -EINVAL;
+        if (cb->aio_offset < 0) return -EINVAL;
+        if ((oflags & O_ACCMODE) == O_WRONLY) return -EBADF;
+        break;
+    case LIO_WRITE:
+        if (cb->aio_buf == NULL) return -EINVAL;
+        if ((oflags & O_ACCMODE) != O_WRONLY &&
+            (oflags & O_ACCMODE) != O_RDWR)
+            return -EBADF;
+        break;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+static void aio_submit(struct aiocb *cb, int op, struct aio_lio_group *group)
+{
+    int index;
+
+    cb->aio_op = op;
+    cb->aio_result = -EINPROGRESS;
+    cb->aio_thread = rt_thread_self();
+    cb->aio_group = group;
+
+    rt_mutex_take(&aio_lock, RT_WAITING_FOREVER);
+    if (group)
+        group->remaining++;
+    rt_list_insert_before(&aio_pending, &cb->aio_node);
+
+    /* a kick still queued finds the request when it runs */
+    for (index = 0; index < RT_POSIX_AIO_WORKERS + 1; index++)
+    {
+        if (rt_workqueue_dowork(aio_queue, &aio_kick[index]) == RT_EOK)
+            break;
+    }
+    rt_mutex_release(&aio_lock);
+}
+
 /**
  * The aio_cancel() function shall attempt to cancel one or more asynchronous I/O 
  * requests currently outstanding against file descriptor fildes. The aiocbp 
@@ -45,19 +407,48 @@ struct rt_workqueue* aio_queue = NULL;
  */
 int aio_cancel(int fd, struct aiocb *cb)
 {
-    rt_err_t ret;
+    struct aiocb *item;
+    rt_list_t cancelled;
+    rt_list_t *node, *next;
+    int ret;
 
-    if (!cb) return -EINVAL;
-    if (cb->aio_fildes != fd) return -EINVAL;
+    if (cb && cb->aio_fildes != fd) return -EINVAL;
 
-    ret = rt_workqueue_cancel_work_sync(aio_queue, &(cb->aio_work));
-    if (ret == RT_EOK)
+    rt_list_init(&cancelled);
+    rt_mutex_take(&aio_lock, RT_WAITING_FOREVER);
+    for (node = aio_pending.next; node != &aio_pending; node = next)
     {
-        errno = -ECANCELED;
-        return -1;
+        next = node->next;
+        item = rt_list_entry(node, struct aiocb, aio_node);
+        if (item->aio_fildes != fd || (cb && item != cb))
+            continue;
+
+        rt_list_remove(&item->aio_node);
+        rt_list_insert_before(&cancelled, &item->aio_node);
     }
 
-    return 0;
+    if (!rt_list_isempty(&cancelled))
+    {
+        ret = AIO_CANCELED;
+    }
+    else
+    {
+        /* what is left of fd is in the hands of a worker */
+        if (cb ? cb->aio_result == -EINPROGRESS : aio_fd_busy(fd))
+            ret = AIO_NOTCANCELED;
+        else
+            ret = AIO_ALLDONE;
+    }
+    rt_mutex_release(&aio_lock);
+
+    while (!rt_list_isempty(&cancelled))
+    {
+        item = rt_list_entry(cancelled.next, struct aiocb, aio_node);
+        rt_list_remove(&item->aio_node);
+        aio_complete(item, -ECANCELED);
+    }
+
+    return ret;
 }
 
 /**
@@ -70,7 +461,8 @@ int aio_error (const struct aiocb *cb)
 {
     if (cb)
     {
-        return cb->aio_result;
+        /* the byte count of aio_return() is not an error */
+        return (cb->aio_result < 0) ? cb->aio_result : 0;
     }
 
     return -EINVAL;
@@ -117,65 +509,17 @@ int aio_error (const struct aiocb *cb)
  * If the aio_fsync() function fails or aiocbp indicates an error condition, 
  * data is not guaranteed to have been successfully transferred.
  */
-static void aio_fync_work(struct rt_work* work, void* work_data)
-{
-    int result;
-    rt_ubase_t level;
-    struct aiocb *cb = (struct aiocb*)work_data;
-
-    RT_ASSERT(cb != RT_NULL);
-
-    result = fsync(cb->aio_fildes);
-    /* modify result */
-    level = rt_hw_interrupt_disable();
-    if (result < 0)
-        cb->aio_result = errno;
-    else
-        cb->aio_result = 0;
-    rt_hw_interrupt_enable(level);
-
-    return ;
-}
-
 int aio_fsync(int op, struct aiocb *cb)
 {
-    rt_ubase_t level;
     if (!cb) return -EINVAL;
+    if (fcntl(cb->aio_fildes, F_GETFL, 0) < 0) return -EBADF;
 
-    level = rt_hw_interrupt_disable();
-    cb->aio_result = -EINPROGRESS;
-    rt_hw_interrupt_enable(level);
-
-    rt_work_init(&(cb->aio_work), aio_fync_work, cb);
-    rt_workqueue_dowork(aio_queue, &(cb->aio_work));
+    /* queued behind the requests of the file, so they are synchronized too */
+    aio_submit(cb, AIO_OP_FSYNC, RT_NULL);
 
     return 0;
 }
 
-static void aio_read_work(struct rt_work* work, void* work_data)
-{
-    int len;
-    rt_ubase_t level;
-    uint8_t *buf_ptr;
-    struct aiocb *cb = (struct aiocb*)work_data;
-
-    buf_ptr = (uint8_t*)cb->aio_buf;
-
-    /* seek to offset */
-    lseek(cb->aio_fildes, cb->aio_offset, SEEK_SET);
-    len = read(cb->aio_fildes, &buf_ptr[cb->aio_offset], cb->aio_nbytes);
-
-    /* modify result */
-    level = rt_hw_interrupt_disable();
-    if (len <= 0)
-        cb->aio_result = errno;
-    else 
-        cb->aio_result = len;
-    rt_hw_interrupt_enable(level);
-
-    return ;
-}
-
 /**
  * The aio_read() function shall read aiocbp->aio_nbytes from the file associated 
  * with aiocbp->aio_fildes into the buffer pointed to by aiocbp->aio_buf. The 
@@ -225,18 +569,12 @@ static void aio_read_work(struct rt_work* work, void* work_data)
  */
 int aio_read(struct aiocb *cb)
 {
-    rt_ubase_t level;
+    int ret;
 
-    if (!cb) return -EINVAL;
-    if (cb->aio_offset < 0) return -EINVAL;
-
-    level = rt_hw_interrupt_disable();
-    cb->aio_result = -EINPROGRESS;
-    rt_hw_interrupt_enable(level);
+    ret = aio_check(cb, LIO_READ);
+    if (ret < 0) return ret;
 
-    /* en-queue read work */
-    rt_work_init(&(cb->aio_work), aio_read_work, cb);
-    rt_workqueue_dowork(aio_queue, &(cb->aio_work));
+    aio_submit(cb, LIO_READ, RT_NULL);
 
     return 0;
 }
@@ -290,36 +628,59 @@ ssize_t  aio_return(struct aiocb *cb)
 int aio_suspend(const struct aiocb *const list[], int nent,
              const struct timespec *timeout)
 {
-    return -ENOSYS;
-}
-
-static void aio_write_work(struct rt_work* work, void* work_data)
-{
-    int len, oflags, level;
-    uint8_t *buf_ptr;
-    struct aiocb *cb = (struct aiocb*)work_data;
+    struct aio_waiter waiter;
+    rt_tick_t deadline = 0;
+    rt_int32_t wait = RT_WAITING_FOREVER;
+    rt_bool_t waiting = RT_FALSE;
+    int index, ret = -EAGAIN;
 
-    buf_ptr = (uint8_t*)cb->aio_buf;
+    if (!list || nent <= 0) return -EINVAL;
 
-    /* whether seek offset */
-    oflags = fcntl(cb->aio_fildes, F_GETFL, 0);
-    if ((oflags & O_APPEND) == 0)
+    if (timeout)
     {
-        lseek(cb->aio_fildes, SEEK_SET, cb->aio_offset);
+        deadline = rt_tick_get() + timeout->tv_sec * RT_TICK_PER_SECOND +
+                   timeout->tv_nsec / (1000000000 / RT_TICK_PER_SECOND);
     }
+    rt_sem_init(&waiter.sem, "aio", 0, RT_IPC_FLAG_FIFO);
 
-    /* write data */
-    len = write(cb->aio_fildes, buf_ptr, cb->aio_nbytes);
+    while (1)
+    {
+        /* checked and registered at once, so no completion is missed */
+        rt_mutex_take(&aio_lock, RT_WAITING_FOREVER);
+        for (index = 0; index < nent; index++)
+        {
+            if (list[index] && list[index]->aio_result != -EINPROGRESS)
+                ret = 0;
+        }
+        if (ret != 0 && !waiting)
+        {
+            rt_list_insert_before(&aio_waiters, &waiter.list);
+            waiting = RT_TRUE;
+        }
+        rt_mutex_release(&aio_lock);
+
+        if (ret == 0)
+            break;
+
+        if (timeout)
+        {
+            wait = (rt_int32_t)(deadline - rt_tick_get());
+            if (wait <= 0)
+                break;
+        }
+        if (rt_sem_take(&waiter.sem, wait) != RT_EOK)
+            break;
+    }
 
-    /* modify result */
-    level = rt_hw_interrupt_disable();
-    if (len <= 0)
-        cb->aio_result = errno;
-    else 
-        cb->aio_result = len;
-    rt_hw_interrupt_enable(level);
+    if (waiting)
+    {
+        rt_mutex_take(&aio_lock, RT_WAITING_FOREVER);
+        rt_list_remove(&waiter.list);
+        rt_mutex_release(&aio_lock);
+    }
+    rt_sem_detach(&waiter.sem);
 
-    return;
+    return ret;
 }
 
 /**
@@ -363,23 +724,12 @@ static void aio_write_work(struct rt_work* work, void* work_data)
  */
 int aio_write(struct aiocb *cb)
 {
-    int oflags;
-    rt_ubase_t level;
+    int ret;
 
-    if (!cb || (cb->aio_buf == NULL)) return -EINVAL;
+    ret = aio_check(cb, LIO_WRITE);
+    if (ret < 0) return ret;
 
-    /* check access mode */
-    oflags = fcntl(cb->aio_fildes, F_GETFL, 0);
-    if ((oflags & O_ACCMODE) != O_WRONLY ||
-        (oflags & O_ACCMODE) != O_RDWR)
-        return -EINVAL;
-
-    level = rt_hw_interrupt_disable();
-    cb->aio_result = -EINPROGRESS;
-    rt_hw_interrupt_enable(level);
-
-    rt_work_init(&(cb->aio_work), aio_write_work, cb);
-    rt_workqueue_dowork(aio_queue, &(cb->aio_work));
+    aio_submit(cb, LIO_WRITE, RT_NULL);
 
     return 0;
 }
@@ -452,12 +802,82 @@ int aio_write(struct aiocb *cb)
 int lio_listio(int mode, struct aiocb * const list[], int nent,
             struct sigevent *sig)
 {
-    return -ENOSYS;
+    struct aio_lio_group *group = RT_NULL;
+    struct aio_lio_group wait_group;
+    struct rt_semaphore done;
+    int index, op, last, ret = 0;
+
+    if (!list || nent <= 0) return -EINVAL;
+    if (mode != LIO_WAIT && mode != LIO_NOWAIT) return -EINVAL;
+
+    if (mode == LIO_WAIT)
+    {
+        rt_sem_init(&done, "lio", 0, RT_IPC_FLAG_FIFO);
+        group = &wait_group;
+        group->done = &done;
+    }
+    else if (sig && sig->sigev_notify != SIGEV_NONE)
+    {
+        group = (struct aio_lio_group *)rt_malloc(sizeof(struct aio_lio_group));
+        if (!group) return -EAGAIN;
+
+        group->sig = *sig;
+        group->thread = rt_thread_self();
+        group->done = RT_NULL;
+    }
+
+    /* held over the whole list, so workers find adjacent requests together */
+    rt_mutex_take(&aio_lock, RT_WAITING_FOREVER);
+    if (group)
+        group->remaining = 1;
+    for (index = 0; index < nent; index++)
+    {
+        if (!list[index]) continue;
+
+        op = list[index]->aio_lio_opcode;
+        if (op == LIO_NOP) continue;
+
+        if ((op != LIO_READ && op != LIO_WRITE) ||
+                aio_check(list[index], op) < 0)
+        {
+            list[index]->aio_result = -EINVAL;
+            ret = -EIO;
+            continue;
+        }
+        aio_submit(list[index], op, group);
+    }
+    last = group && (--group->remaining == 0);
+    rt_mutex_release(&aio_lock);
+
+    if (mode == LIO_WAIT)
+    {
+        if (!last)
+            rt_sem_take(&done, RT_WAITING_FOREVER);
+        rt_sem_detach(&done);
+    }
+    else if (last)
+    {
+        aio_notify(&group->sig, group->thread);
+        rt_free(group);
+    }
+
+    return ret;
 }
 
 int aio_system_init(void)
 {
-    aio_queue = rt_workqueue_create("aio", 2048, RT_THREAD_PRIORITY_MAX/2);
+    int slot;
+
+    rt_mutex_init(&aio_lock, "aio", RT_IPC_FLAG_FIFO);
+    rt_list_init(&aio_pending);
+    rt_list_init(&aio_waiters);
+    for (slot = 0; slot < RT_POSIX_AIO_WORKERS; slot++)
+        aio_busy_fd[slot] = -1;
+    for (slot = 0; slot < RT_POSIX_AIO_WORKERS + 1; slot++)
+        rt_work_init(&aio_kick[slot], aio_work, RT_NULL);
+
+    aio_queue = rt_workqueue_create_workers("aio", 2048, RT_THREAD_PRIORITY_MAX/2,
+                                            RT_POSIX_AIO_WORKERS);
     RT_ASSERT(aio_queue != NULL);
 
     return 0;
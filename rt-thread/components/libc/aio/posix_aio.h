@@ -6,11 +6,37 @@
  * Change Logs:
  * Date           Author       Notes
  * 2017/12/30     Bernard      The first version.
+ * 2026-10-19     yqiu         add the request list and notification state
  */
 
 #ifndef POSIX_AIO_H__
 #define POSIX_AIO_H__
 
+#ifndef LIO_READ
+#define LIO_READ        0
+#define LIO_WRITE       1
+#define LIO_NOP         2
+#endif
+
+#ifndef LIO_WAIT
+#define LIO_WAIT        0
+#define LIO_NOWAIT      1
+#endif
+
+#ifndef AIO_CANCELED
+#define AIO_CANCELED    0
+#define AIO_NOTCANCELED 1
+#define AIO_ALLDONE     2
+#endif
+
+#ifndef SIGEV_NONE
+#define SIGEV_NONE      1
+#define SIGEV_SIGNAL    2
+#define SIGEV_THREAD    3
+#endif
+
+struct aio_lio_group;
+
 struct aiocb
 {
     int aio_fildes;         /* File descriptor. */
@@ -23,7 +49,10 @@ struct aiocb
     int aio_lio_opcode;     /* Operation to be performed. */
 
     int aio_result;
-    struct rt_work aio_work;
+    int aio_op;
+    rt_list_t aio_node;     /* in the pending requests */
+    rt_thread_t aio_thread; /* the submitter, signalled on completion */
+    struct aio_lio_group *aio_group;
 };
 
 int aio_cancel(int fd, struct aiocb *cb);
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         the first version
+ */
+
+#include <rthw.h>
+#include <rtdevice.h>
+#include <ulog.h>
+
+#ifdef ULOG_BACKEND_USING_FAL
+
+#include <fal.h>
+
+#ifndef ULOG_FAL_PART_NAME
+#define ULOG_FAL_PART_NAME             "ulog"
+#endif
+#ifndef ULOG_FAL_PART_NUM
+#define ULOG_FAL_PART_NUM              2
+#endif
+#ifndef ULOG_FAL_SECTOR_SIZE
+#define ULOG_FAL_SECTOR_SIZE           4096
+#endif
+#ifndef ULOG_FAL_FLUSH_MS
+#define ULOG_FAL_FLUSH_MS              1000
+#endif
+
+/*
+ * The partitions "ulog0", "ulog1", ... form one ring of erase sectors. The
+ * lines are collected in a sector buffer and programmed in one write when it
+ * is full; a flush programs the part not yet programmed. The sector after the
+ * current one is erased before it, so after a reset the logging resumes at
+ * the first erased sector behind a written one, and the oldest partition is
+ * overwritten when the ring wraps.
+ */
+struct ulog_fal_backend
+{
+    struct ulog_backend parent;
+    struct rt_mutex lock;
+    struct rt_delayed_work flush_work;
+    rt_bool_t flush_pending;
+
+    const struct fal_partition *part[ULOG_FAL_PART_NUM];
+    rt_bool_t ready;
+    rt_uint32_t sector_num;
+    rt_uint32_t sector;                         /* current sector in the ring */
+
+    rt_uint32_t buf_len;
+    rt_uint32_t programmed;                     /* bytes of the buffer already in the flash */
+    rt_uint8_t buf[ULOG_FAL_SECTOR_SIZE];
+};
+
+static struct ulog_fal_backend fal_be;
+
+/* the partition and the address in it of a sector of the ring */
+static const struct fal_partition *sector_locate(rt_uint32_t sector, rt_uint32_t *addr)
+{
+    rt_uint32_t i, num;
+
+    for (i = 0; i < ULOG_FAL_PART_NUM; i++)
+    {
+        num = fal_be.part[i]->len / ULOG_FAL_SECTOR_SIZE;
+        if (sector < num)
+        {
+            *addr = sector * ULOG_FAL_SECTOR_SIZE;
+            return fal_be.part[i];
+        }
+        sector -= num;
+    }
+
+    return RT_NULL;
+}
+
+static rt_bool_t sector_erased(rt_uint32_t sector)
+{
+    const struct fal_partition *part;
+    rt_uint32_t addr, word = 0;
+
+    part = sector_locate(sector, &addr);
+    fal_partition_read(part, addr, (rt_uint8_t *) &word, sizeof(word));
+
+    return word == 0xFFFFFFFF;
+}
+
+static void sector_erase(rt_uint32_t sector)
+{
+    const struct fal_partition *part;
+    rt_uint32_t addr;
+
+    part = sector_locate(sector, &addr);
+    fal_partition_erase(part, addr, ULOG_FAL_SECTOR_SIZE);
+}
+
+/* find the partitions and the sector to resume at */
+static rt_bool_t fal_open(void)
+{
+    char name[RT_NAME_MAX + 4];
+    rt_uint32_t i;
+
+    fal_be.sector_num = 0;
+    for (i = 0; i < ULOG_FAL_PART_NUM; i++)
+    {
+        rt_snprintf(name, sizeof(name), "%s%d", ULOG_FAL_PART_NAME, i);
+        fal_be.part[i] = fal_partition_find(name);
+        if (fal_be.part[i] == RT_NULL)
+        {
+            return RT_FALSE;
+        }
+        RT_ASSERT(fal_be.part[i]->len % ULOG_FAL_SECTOR_SIZE == 0);
+        fal_be.sector_num += fal_be.part[i]->len / ULOG_FAL_SECTOR_SIZE;
+    }
+    RT_ASSERT(fal_be.sector_num >= 2);
+
+    fal_be.sector = 0;
+    for (i = 0; i < fal_be.sector_num; i++)
+    {
+        if (sector_erased(i) && !sector_erased((i + fal_be.sector_num - 1) % fal_be.sector_num))
+        {
+            fal_be.sector = i;
+            break;
+        }
+    }
+
+    /* a blank or a damaged ring starts from the first sector */
+    if (!sector_erased(fal_be.sector))
+    {
+        sector_erase(fal_be.sector);
+    }
+    fal_be.programmed = 0;
+    fal_be.ready = RT_TRUE;
+
+    return RT_TRUE;
+}
+
+/* program the rest of the buffer, a full buffer moves on to the next sector */
+static void fal_write(void)
+{
+    const struct fal_partition *part;
+    rt_uint32_t addr;
+
+    if (fal_be.buf_len == fal_be.programmed)
+    {
+        return;
+    }
+
+    if (!fal_be.ready && !fal_open())
+    {
+        if (fal_be.buf_len == ULOG_FAL_SECTOR_SIZE)
+        {
+            /* no partition yet, keep the latest logs only */
+            fal_be.buf_len = 0;
+        }
+        return;
+    }
+
+    /* keep an erased sector ahead of the one being written */
+    if (fal_be.programmed == 0)
+    {
+        sector_erase((fal_be.sector + 1) % fal_be.sector_num);
+    }
+
+    part = sector_locate(fal_be.sector, &addr);
+    fal_partition_write(part, addr + fal_be.programmed, fal_be.buf + fal_be.programmed,
+            fal_be.buf_len - fal_be.programmed);
+    fal_be.programmed = fal_be.buf_len;
+
+    if (fal_be.buf_len == ULOG_FAL_SECTOR_SIZE)
+    {
+        fal_be.sector = (fal_be.sector + 1) % fal_be.sector_num;
+        fal_be.buf_len = 0;
+        fal_be.programmed = 0;
+    }
+}
+
+static void fal_flush_work(struct rt_work *work, void *work_data)
+{
+    rt_mutex_take(&fal_be.lock, RT_WAITING_FOREVER);
+    fal_be.flush_pending = RT_FALSE;
+    fal_write();
+    rt_mutex_release(&fal_be.lock);
+}
+
+static void ulog_fal_backend_output(struct ulog_backend *backend, rt_uint32_t level, const char *tag,
+        rt_bool_t is_raw, const char *log, size_t len)
+{
+    rt_size_t copy;
+    rt_bool_t submit = RT_FALSE;
+
+    /* the logs from an ISR only go to the console */
+    if (rt_interrupt_get_nest() != 0)
+    {
+        return;
+    }
+
+    rt_mutex_take(&fal_be.lock, RT_WAITING_FOREVER);
+    while (len)
+    {
+        copy = ULOG_FAL_SECTOR_SIZE - fal_be.buf_len;
+        if (copy > len)
+        {
+            copy = len;
+        }
+        rt_memcpy(fal_be.buf + fal_be.buf_len, log, copy);
+        fal_be.buf_len += copy;
+        log += copy;
+        len -= copy;
+
+        if (fal_be.buf_len == ULOG_FAL_SECTOR_SIZE)
+        {
+            fal_write();
+        }
+    }
+
+    if (fal_be.buf_len != fal_be.programmed && !fal_be.flush_pending)
+    {
+        fal_be.flush_pending = RT_TRUE;
+        submit = RT_TRUE;
+    }
+    rt_mutex_release(&fal_be.lock);
+
+    /* a work not queued, e.g. on a full delayed heap, is tried again on the next append */
+    if (submit && rt_work_submit(&fal_be.flush_work.work, rt_tick_from_millisecond(ULOG_FAL_FLUSH_MS)) != RT_EOK)
+    {
+        rt_mutex_take(&fal_be.lock, RT_WAITING_FOREVER);
+        fal_be.flush_pending = RT_FALSE;
+        rt_mutex_release(&fal_be.lock);
+    }
+}
+
+static void ulog_fal_backend_flush(struct ulog_backend *backend)
+{
+    if (rt_interrupt_get_nest() != 0)
+    {
+        return;
+    }
+
+    rt_mutex_take(&fal_be.lock, RT_WAITING_FOREVER);
+    fal_write();
+    rt_mutex_release(&fal_be.lock);
+}
+
+static void ulog_fal_backend_deinit(struct ulog_backend *backend)
+{
+    rt_work_cancel(&fal_be.flush_work.work);
+    ulog_fal_backend_flush(backend);
+}
+
+int ulog_fal_backend_init(void)
+{
+    ulog_init();
+
+    rt_mutex_init(&fal_be.lock, "ulog_fal", RT_IPC_FLAG_FIFO);
+    rt_delayed_work_init(&fal_be.flush_work, fal_flush_work, RT_NULL);
+
+    fal_be.parent.output = ulog_fal_backend_output;
+    fal_be.parent.flush = ulog_fal_backend_flush;
+    fal_be.parent.deinit = ulog_fal_backend_deinit;
+
+    /* the partitions are looked up on the first write, after fal_init() */
+    ulog_backend_register(&fal_be.parent, "fal", RT_FALSE);
+
+    return 0;
+}
+INIT_PREV_EXPORT(ulog_fal_backend_init);
+
+#endif /* ULOG_BACKEND_USING_FAL */
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         the first version
+ */
+
+#include <rthw.h>
+#include <rtdevice.h>
+#include <ulog.h>
+
+#ifdef ULOG_BACKEND_USING_FILE
+
+#include <dfs_posix.h>
+
+#ifndef ULOG_FILE_ROOT_PATH
+#define ULOG_FILE_ROOT_PATH            "/logs"
+#endif
+#ifndef ULOG_FILE_NAME
+#define ULOG_FILE_NAME                 "ulog.log"
+#endif
+#ifndef ULOG_FILE_MAX_NUM
+#define ULOG_FILE_MAX_NUM              4
+#endif
+#ifndef ULOG_FILE_MAX_SIZE
+#define ULOG_FILE_MAX_SIZE             (64 * 1024)
+#endif
+#ifndef ULOG_FILE_BUF_SIZE
+#define ULOG_FILE_BUF_SIZE             512
+#endif
+#ifndef ULOG_FILE_FLUSH_MS
+#define ULOG_FILE_FLUSH_MS             1000
+#endif
+
+#define ULOG_FILE_PATH_MAX             (sizeof(ULOG_FILE_ROOT_PATH "/" ULOG_FILE_NAME) + 4)
+
+/*
+ * The lines are collected in a sector sized buffer which is always written
+ * at a sector aligned file offset. A flush before the buffer is full writes
+ * the same sector again later, so the file system never sees unaligned or
+ * partial sector writes from the log.
+ */
+struct ulog_file_backend
+{
+    struct ulog_backend parent;
+    struct rt_mutex lock;
+    struct rt_delayed_work flush_work;
+    rt_bool_t flush_pending;
+
+    int fd;
+    rt_uint32_t sector_offset;                  /* file offset of the buffer */
+    rt_uint32_t buf_len;
+    rt_uint8_t buf[ULOG_FILE_BUF_SIZE];
+};
+
+static struct ulog_file_backend file_be;
+
+static void file_path(char *path, int index)
+{
+    if (index < 0)
+    {
+        rt_snprintf(path, ULOG_FILE_PATH_MAX, "%s/%s", ULOG_FILE_ROOT_PATH, ULOG_FILE_NAME);
+    }
+    else
+    {
+        rt_snprintf(path, ULOG_FILE_PATH_MAX, "%s/%s.%d", ULOG_FILE_ROOT_PATH, ULOG_FILE_NAME, index);
+    }
+}
+
+/* open the current log file and reload its last partial sector */
+static rt_bool_t file_open(void)
+{
+    char path[ULOG_FILE_PATH_MAX];
+    off_t size;
+    struct stat buf;
+
+    if (stat(ULOG_FILE_ROOT_PATH, &buf) < 0 && mkdir(ULOG_FILE_ROOT_PATH, 0) < 0)
+    {
+        return RT_FALSE;
+    }
+
+    file_path(path, -1);
+    file_be.fd = open(path, O_RDWR | O_CREAT, 0);
+    if (file_be.fd < 0)
+    {
+        return RT_FALSE;
+    }
+
+    size = lseek(file_be.fd, 0, SEEK_END);
+    if (size < 0)
+    {
+        size = 0;
+    }
+    file_be.sector_offset = RT_ALIGN_DOWN(size, ULOG_FILE_BUF_SIZE);
+
+    /* the logs since the last open go after the old tail */
+    if (size > file_be.sector_offset)
+    {
+        rt_size_t tail = size - file_be.sector_offset;
+        rt_size_t excess = 0;
+
+        /* keep the newest logs when both do not fit in the sector */
+        if (file_be.buf_len + tail > ULOG_FILE_BUF_SIZE)
+        {
+            excess = file_be.buf_len + tail - ULOG_FILE_BUF_SIZE;
+            file_be.buf_len -= excess;
+        }
+        rt_memmove(file_be.buf + tail, file_be.buf + excess, file_be.buf_len);
+        lseek(file_be.fd, file_be.sector_offset, SEEK_SET);
+        read(file_be.fd, file_be.buf, tail);
+        file_be.buf_len += tail;
+    }
+
+    return RT_TRUE;
+}
+
+/* ulog.log.N-2 -> ulog.log.N-1, ..., ulog.log -> ulog.log.0 */
+static void file_rotate(void)
+{
+    char old_path[ULOG_FILE_PATH_MAX], new_path[ULOG_FILE_PATH_MAX];
+    int index;
+
+    close(file_be.fd);
+    file_be.fd = -1;
+
+    file_path(new_path, ULOG_FILE_MAX_NUM - 2);
+    unlink(new_path);
+    for (index = ULOG_FILE_MAX_NUM - 2; index >= 0; index--)
+    {
+        file_path(old_path, index - 1);
+        file_path(new_path, index);
+        rename(old_path, new_path);
+    }
+
+    file_be.sector_offset = 0;
+    file_open();
+}
+
+/* write the buffer to its sector, a full buffer moves on to the next sector */
+static void file_write(rt_bool_t sync)
+{
+    if (file_be.buf_len == 0)
+    {
+        return;
+    }
+
+    if (file_be.fd < 0 && !file_open())
+    {
+        if (file_be.buf_len == ULOG_FILE_BUF_SIZE)
+        {
+            /* no file system yet, keep the latest logs only */
+            file_be.buf_len = 0;
+        }
+        return;
+    }
+
+    lseek(file_be.fd, file_be.sector_offset, SEEK_SET);
+    write(file_be.fd, file_be.buf, file_be.buf_len);
+
+    if (file_be.buf_len == ULOG_FILE_BUF_SIZE)
+    {
+        file_be.sector_offset += ULOG_FILE_BUF_SIZE;
+        file_be.buf_len = 0;
+
+        if (file_be.sector_offset >= ULOG_FILE_MAX_SIZE)
+        {
+            file_rotate();
+        }
+    }
+
+    if (sync && file_be.fd >= 0)
+    {
+        fsync(file_be.fd);
+    }
+}
+
+static void file_flush_work(struct rt_work *work, void *work_data)
+{
+    rt_mutex_take(&file_be.lock, RT_WAITING_FOREVER);
+    file_be.flush_pending = RT_FALSE;
+    file_write(RT_TRUE);
+    rt_mutex_release(&file_be.lock);
+}
+
+/* append to the buffer and write the full sectors, the rest is flushed later */
+static void file_append(const rt_uint8_t *data, rt_size_t len)
+{
+    rt_size_t copy;
+    rt_bool_t submit = RT_FALSE;
+
+    rt_mutex_take(&file_be.lock, RT_WAITING_FOREVER);
+    while (len)
+    {
+        copy = ULOG_FILE_BUF_SIZE - file_be.buf_len;
+        if (copy > len)
+        {
+            copy = len;
+        }
+        rt_memcpy(file_be.buf + file_be.buf_len, data, copy);
+        file_be.buf_len += copy;
+        data += copy;
+        len -= copy;
+
+        if (file_be.buf_len == ULOG_FILE_BUF_SIZE)
+        {
+            file_write(RT_FALSE);
+        }
+    }
+
+    if (file_be.buf_len && !file_be.flush_pending)
+    {
+        file_be.flush_pending = RT_TRUE;
+        submit = RT_TRUE;
+    }
+    rt_mutex_release(&file_be.lock);
+
+    /* a work not queued, e.g. on a full delayed heap, is tried again on the next append */
+    if (submit && rt_work_submit(&file_be.flush_work.work, rt_tick_from_millisecond(ULOG_FILE_FLUSH_MS)) != RT_EOK)
+    {
+        rt_mutex_take(&file_be.lock, RT_WAITING_FOREVER);
+        file_be.flush_pending = RT_FALSE;
+        rt_mutex_release(&file_be.lock);
+    }
+}
+
+static void ulog_file_backend_output(struct ulog_backend *backend, rt_uint32_t level, const char *tag,
+        rt_bool_t is_raw, const char *log, size_t len)
+{
+    /* the logs from an ISR only go to the console */
+    if (rt_interrupt_get_nest() != 0)
+    {
+        return;
+    }
+
+    file_append((const rt_uint8_t *)log, len);
+}
+
+#ifdef ULOG_FILE_BINARY
+/* the frame is written padded to RT_ALIGN_SIZE, as ulog_decode.py expects */
+static void ulog_file_backend_output_bin(struct ulog_backend *backend, const struct ulog_bin_frame *frame,
+        size_t len)
+{
+    rt_ubase_t buf[RT_ALIGN(sizeof(struct ulog_bin_frame) + ULOG_BIN_ARGS_MAX * sizeof(rt_ubase_t), RT_ALIGN_SIZE)
+                   / sizeof(rt_ubase_t)];
+
+    if (rt_interrupt_get_nest() != 0)
+    {
+        return;
+    }
+
+    len = sizeof(struct ulog_bin_frame) + frame->argc * sizeof(rt_ubase_t);
+    rt_memset(buf, 0, sizeof(buf));
+    rt_memcpy(buf, frame, len);
+    file_append((const rt_uint8_t *)buf, RT_ALIGN(len, RT_ALIGN_SIZE));
+}
+#endif /* ULOG_FILE_BINARY */
+
+static void ulog_file_backend_flush(struct ulog_backend *backend)
+{
+    if (rt_interrupt_get_nest() != 0)
+    {
+        return;
+    }
+
+    rt_mutex_take(&file_be.lock, RT_WAITING_FOREVER);
+    file_write(RT_TRUE);
+    rt_mutex_release(&file_be.lock);
+}
+
+static void ulog_file_backend_deinit(struct ulog_backend *backend)
+{
+    rt_work_cancel(&file_be.flush_work.work);
+
+    rt_mutex_take(&file_be.lock, RT_WAITING_FOREVER);
+    file_write(RT_TRUE);
+    if (file_be.fd >= 0)
+    {
+        close(file_be.fd);
+        file_be.fd = -1;
+    }
+    rt_mutex_release(&file_be.lock);
+}
+
+int ulog_file_backend_init(void)
+{
+    ulog_init();
+
+    file_be.fd = -1;
+    rt_mutex_init(&file_be.lock, "ulog_f", RT_IPC_FLAG_FIFO);
+    rt_delayed_work_init(&file_be.flush_work, file_flush_work, RT_NULL);
+
+    file_be.parent.output = ulog_file_backend_output;
+    file_be.parent.flush = ulog_file_backend_flush;
+    file_be.parent.deinit = ulog_file_backend_deinit;
+#ifdef ULOG_FILE_BINARY
+    file_be.parent.output_bin = ulog_file_backend_output_bin;
+#endif
+
+    /* the file is opened on the first write, after the file system is mounted */
+    ulog_backend_register(&file_be.parent, "file", RT_FALSE);
+
+    return 0;
+}
+INIT_PREV_EXPORT(ulog_file_backend_init);
+
+#endif /* ULOG_BACKEND_USING_FILE */
@@ -13,7 +13,7 @@
 #include <rthw.h>
 #include "syslog.h"
 
-#ifdef ULOG_OUTPUT_FLOAT
+#if defined(ULOG_OUTPUT_FLOAT) && !defined(RT_PRINTF_FLOAT)
 #include <stdio.h>
 #endif
 
@@ -227,7 +227,7 @@ RT_WEAK rt_size_t syslog_formater(char *log_buf, int level, const char *tag, rt_
 
     log_len += ulog_strcpy(log_len, log_buf + log_len, ": ");
 
-#ifdef ULOG_OUTPUT_FLOAT
+#if defined(ULOG_OUTPUT_FLOAT) && !defined(RT_PRINTF_FLOAT)
     fmt_result = vsnprintf(log_buf + log_len, ULOG_LINE_BUF_SIZE - log_len, format, args);
 #else
     fmt_result = rt_vsnprintf(log_buf + log_len, ULOG_LINE_BUF_SIZE - log_len, format, args);
@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-08-25     armink       the first version
+ * 2026-10-19     yqiu         add binary log mode
+ * 2026-10-19     yqiu         add lock-free per-context buffers
  */
 
 #include <stdarg.h>
@@ -16,7 +18,7 @@
 #include <syslog.h>
 #endif
 
-#ifdef ULOG_OUTPUT_FLOAT
+#if defined(ULOG_OUTPUT_FLOAT) && !defined(RT_PRINTF_FLOAT)
 #include <stdio.h>
 #endif
 
@@ -30,10 +32,45 @@
 
 #ifdef RT_USING_ULOG
 
+#if defined(ULOG_USING_BINARY) && !defined(ULOG_USING_ASYNC_OUTPUT)
+#error "the binary log mode must using async output mode (ULOG_USING_ASYNC_OUTPUT)"
+#endif
+
+#ifdef ULOG_USING_CONTEXT_BUF
+#ifndef ULOG_USING_ASYNC_OUTPUT
+#error "the context buffers must using async output mode (ULOG_USING_ASYNC_OUTPUT)"
+#endif
+#ifndef ULOG_CONTEXT_BUF_SIZE
+#define ULOG_CONTEXT_BUF_SIZE          512
+#endif
+#ifndef ULOG_CONTEXT_BUF_NUM
+#define ULOG_CONTEXT_BUF_NUM           8
+#endif
+#ifdef ULOG_USING_ISR_LOG
+#ifndef ULOG_CONTEXT_ISR_NUM
+#define ULOG_CONTEXT_ISR_NUM           2
+#endif
+#else
+#define ULOG_CONTEXT_ISR_NUM           0
+#endif
+#define ULOG_CONTEXT_NUM               (ULOG_CONTEXT_BUF_NUM + ULOG_CONTEXT_ISR_NUM)
+
+/* the callers format in their own buffers at the same time */
+#define ULOG_FORMATER_STATIC
+#else
+/* the caller has locker, so it can use static variable for reduce stack usage */
+#define ULOG_FORMATER_STATIC           static
+#endif /* ULOG_USING_CONTEXT_BUF */
+
 /* the number which is max stored line logs */
 #ifndef ULOG_ASYNC_OUTPUT_STORE_LINES
+#ifdef ULOG_USING_BINARY
+/* binary frames are much smaller than the lines */
+#define ULOG_ASYNC_OUTPUT_STORE_LINES  (ULOG_ASYNC_OUTPUT_BUF_SIZE / 32)
+#else
 #define ULOG_ASYNC_OUTPUT_STORE_LINES  (ULOG_ASYNC_OUTPUT_BUF_SIZE * 3 / 2 / ULOG_LINE_BUF_SIZE)
 #endif
+#endif
 
 #ifdef ULOG_USING_COLOR
 /**
@@ -74,6 +111,41 @@
 #error "the log line buffer size must more than 80"
 #endif
 
+#ifdef ULOG_USING_CONTEXT_BUF
+/* record header in a context ring, a log frame or a binary frame follows */
+struct ulog_ctx_rec
+{
+    rt_uint32_t seq;
+    rt_uint32_t len;
+};
+
+#define ULOG_CONTEXT_REC_MAX           (sizeof(struct ulog_ctx_rec) + sizeof(struct ulog_frame) + ULOG_LINE_BUF_SIZE)
+
+/*
+ * The staging ring of one producer, a thread or an interrupt nest level. The
+ * producer is the only writer of its ring, so it needs no lock, and the async
+ * output is the only reader.
+ */
+struct ulog_ctx
+{
+    rt_thread_t owner;
+    /* a copy, the owner may be deleted while the name is shown */
+    char name[RT_NAME_MAX];
+    struct rt_lfring ring;
+    rt_uint8_t pool[ULOG_CONTEXT_BUF_SIZE];
+    /* the record being built by the producer */
+    rt_uint32_t rec[(ULOG_CONTEXT_REC_MAX + 3) / 4];
+
+    /* lost, and written through the shared locked buffer as the ring was full */
+    rt_uint32_t dropped;
+    rt_uint32_t blocked;
+
+    /* the header of the oldest record, read by the async output */
+    rt_bool_t pending;
+    struct ulog_ctx_rec pending_rec;
+};
+#endif /* ULOG_USING_CONTEXT_BUF */
+
 struct rt_ulog
 {
     rt_bool_t init_ok;
@@ -95,6 +167,24 @@ struct rt_ulog
     struct rt_semaphore async_notice;
 #endif
 
+#ifdef ULOG_USING_BINARY
+    /* the thread which is formatting a binary frame, the frame tick is the log time */
+    rt_thread_t bin_thread;
+    rt_tick_t bin_tick;
+#endif
+
+#ifdef ULOG_USING_CONTEXT_BUF
+    /* the thread producers first, then the interrupt nest levels */
+    struct ulog_ctx ctx[ULOG_CONTEXT_NUM];
+    volatile rt_uint32_t ctx_seq;
+    /* the async output of the context rings */
+    struct rt_mutex ctx_locker;
+    rt_uint32_t ctx_out[(ULOG_CONTEXT_REC_MAX + 3) / 4];
+    /* the threads without a context buffer */
+    volatile rt_uint32_t other_dropped;
+    volatile rt_uint32_t other_blocked;
+#endif
+
 #ifdef ULOG_USING_FILTER
     struct
     {
@@ -211,6 +301,18 @@ static void output_lock(void)
     }
 }
 
+static rt_tick_t get_log_tick(void)
+{
+#ifdef ULOG_USING_BINARY
+    if (ulog.bin_thread && ulog.bin_thread == rt_thread_self() && rt_interrupt_get_nest() == 0)
+    {
+        return ulog.bin_tick;
+    }
+#endif
+
+    return rt_tick_get();
+}
+
 static char *get_log_buf(void)
 {
     /* is in thread context */
@@ -232,9 +334,8 @@ static char *get_log_buf(void)
 RT_WEAK rt_size_t ulog_formater(char *log_buf, rt_uint32_t level, const char *tag, rt_bool_t newline,
         const char *format, va_list args)
 {
-    /* the caller has locker, so it can use static variable for reduce stack usage */
-    static rt_size_t log_len, newline_len;
-    static int fmt_result;
+    ULOG_FORMATER_STATIC rt_size_t log_len, newline_len;
+    ULOG_FORMATER_STATIC int fmt_result;
 
     RT_ASSERT(log_buf);
     RT_ASSERT(level <= LOG_LVL_DBG);
@@ -257,8 +358,8 @@ RT_WEAK rt_size_t ulog_formater(char *log_buf, rt_uint32_t level, const char *ta
     /* add time info */
     {
 #ifdef ULOG_TIME_USING_TIMESTAMP
-        static time_t now;
-        static struct tm *tm, tm_tmp;
+        ULOG_FORMATER_STATIC time_t now;
+        ULOG_FORMATER_STATIC struct tm *tm, tm_tmp;
 
         now = time(NULL);
         tm = gmtime_r(&now, &tm_tmp);
@@ -272,10 +373,10 @@ RT_WEAK rt_size_t ulog_formater(char *log_buf, rt_uint32_t level, const char *ta
 #endif /* RT_USING_SOFT_RTC */
 
 #else
-        static rt_size_t tick_len = 0;
+        ULOG_FORMATER_STATIC rt_size_t tick_len = 0;
 
         log_buf[log_len] = '[';
-        tick_len = ulog_ultoa(log_buf + log_len + 1, rt_tick_get());
+        tick_len = ulog_ultoa(log_buf + log_len + 1, get_log_tick());
         log_buf[log_len + 1 + tick_len] = ']';
         log_buf[log_len + 1 + tick_len + 1] = '\0';
 #endif /* ULOG_TIME_USING_TIMESTAMP */
@@ -329,7 +430,7 @@ RT_WEAK rt_size_t ulog_formater(char *log_buf, rt_uint32_t level, const char *ta
 
     log_len += ulog_strcpy(log_len, log_buf + log_len, ": ");
 
-#ifdef ULOG_OUTPUT_FLOAT
+#if defined(ULOG_OUTPUT_FLOAT) && !defined(RT_PRINTF_FLOAT)
     fmt_result = vsnprintf(log_buf + log_len, ULOG_LINE_BUF_SIZE - log_len, format, args);
 #else
     fmt_result = rt_vsnprintf(log_buf + log_len, ULOG_LINE_BUF_SIZE - log_len, format, args);
@@ -381,6 +482,32 @@ RT_WEAK rt_size_t ulog_formater(char *log_buf, rt_uint32_t level, const char *ta
     return log_len;
 }
 
+static void output_to_backend(ulog_backend_t backend, rt_uint32_t level, const char *tag, rt_bool_t is_raw,
+        const char *log, rt_size_t size)
+{
+#if !defined(ULOG_USING_COLOR) || defined(ULOG_USING_SYSLOG)
+    backend->output(backend, level, tag, is_raw, log, size);
+#else
+    if (backend->support_color)
+    {
+        backend->output(backend, level, tag, is_raw, log, size);
+    }
+    else
+    {
+        /* recalculate the log start address and log size when backend not supported color */
+        rt_size_t color_info_len = rt_strlen(color_output_info[level]), output_size = size;
+        if (color_info_len)
+        {
+            rt_size_t color_hdr_len = rt_strlen(CSI_START) + color_info_len;
+
+            log += color_hdr_len;
+            output_size -= (color_hdr_len + (sizeof(CSI_END) - 1));
+        }
+        backend->output(backend, level, tag, is_raw, log, output_size);
+    }
+#endif /* !defined(ULOG_USING_COLOR) || defined(ULOG_USING_SYSLOG) */
+}
+
 void ulog_output_to_all_backend(rt_uint32_t level, const char *tag, rt_bool_t is_raw, const char *log, rt_size_t size)
 {
     rt_slist_t *node;
@@ -393,31 +520,11 @@ void ulog_output_to_all_backend(rt_uint32_t level, const char *tag, rt_bool_t is
     for (node = rt_slist_first(&ulog.backend_list); node; node = rt_slist_next(node))
     {
         backend = rt_slist_entry(node, struct ulog_backend, list);
-#if !defined(ULOG_USING_COLOR) || defined(ULOG_USING_SYSLOG)
-        backend->output(backend, level, tag, is_raw, log, size);
-#else
-        if (backend->support_color)
-        {
-            backend->output(backend, level, tag, is_raw, log, size);
-        }
-        else
-        {
-            /* recalculate the log start address and log size when backend not supported color */
-            rt_size_t color_info_len = rt_strlen(color_output_info[level]), output_size = size;
-            if (color_info_len)
-            {
-                rt_size_t color_hdr_len = rt_strlen(CSI_START) + color_info_len;
-
-                log += color_hdr_len;
-                output_size -= (color_hdr_len + (sizeof(CSI_END) - 1));
-            }
-            backend->output(backend, level, tag, is_raw, log, output_size);
-        }
-#endif /* !defined(ULOG_USING_COLOR) || defined(ULOG_USING_SYSLOG) */
+        output_to_backend(backend, level, tag, is_raw, log, size);
     }
 }
 
-static void do_output(rt_uint32_t level, const char *tag, rt_bool_t is_raw, const char *log_buf, rt_size_t log_len)
+static rt_err_t do_output(rt_uint32_t level, const char *tag, rt_bool_t is_raw, const char *log_buf, rt_size_t log_len)
 {
 #ifdef ULOG_USING_ASYNC_OUTPUT
     rt_rbb_blk_t log_blk;
@@ -451,6 +558,7 @@ static void do_output(rt_uint32_t level, const char *tag, rt_bool_t is_raw, cons
                     " please increase the ULOG_ASYNC_OUTPUT_BUF_SIZE option.\n");
             already_output = RT_TRUE;
         }
+        return -RT_EFULL;
     }
 #else
     /* is in thread context */
@@ -470,8 +578,137 @@ static void do_output(rt_uint32_t level, const char *tag, rt_bool_t is_raw, cons
 #endif /* ULOG_BACKEND_USING_CONSOLE */
     }
 #endif /* ULOG_USING_ASYNC_OUTPUT */
+
+    return RT_EOK;
+}
+
+#ifdef ULOG_USING_CONTEXT_BUF
+/* whether the owner of a context buffer still runs, the scheduler shall be locked */
+static rt_bool_t ctx_owner_alive(rt_thread_t owner)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+
+    information = rt_object_get_information(RT_Object_Class_Thread);
+    RT_ASSERT(information != RT_NULL);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        if (node == &(owner->list))
+        {
+            return (owner->stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE;
+        }
+    }
+
+    return RT_FALSE;
+}
+
+/* the context buffer of the current thread or interrupt nest level, NULL when there is none */
+static struct ulog_ctx *get_log_ctx(void)
+{
+    rt_thread_t self;
+    rt_uint32_t nest = rt_interrupt_get_nest();
+    int i;
+
+    if (nest != 0)
+    {
+        /* an interrupt is only preempted by the deeper nest levels */
+        return nest <= ULOG_CONTEXT_ISR_NUM ? &ulog.ctx[ULOG_CONTEXT_BUF_NUM + nest - 1] : NULL;
+    }
+
+    self = rt_thread_self();
+    if (self == RT_NULL)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < ULOG_CONTEXT_BUF_NUM; i++)
+    {
+        if (ulog.ctx[i].owner == self)
+        {
+            return &ulog.ctx[i];
+        }
+    }
+
+    /* the first log of this thread, the buffer is kept until the thread is deleted */
+    rt_enter_critical();
+    for (i = 0; i < ULOG_CONTEXT_BUF_NUM; i++)
+    {
+        if (ulog.ctx[i].owner == RT_NULL)
+        {
+            break;
+        }
+    }
+    if (i == ULOG_CONTEXT_BUF_NUM)
+    {
+        /* take over the buffer of a deleted thread, the records left in its ring are still output */
+        for (i = 0; i < ULOG_CONTEXT_BUF_NUM; i++)
+        {
+            if (!ctx_owner_alive(ulog.ctx[i].owner))
+            {
+                break;
+            }
+        }
+    }
+    if (i < ULOG_CONTEXT_BUF_NUM)
+    {
+        rt_strncpy(ulog.ctx[i].name, self->name, RT_NAME_MAX);
+        ulog.ctx[i].owner = self;
+    }
+    rt_exit_critical();
+
+    return i < ULOG_CONTEXT_BUF_NUM ? &ulog.ctx[i] : NULL;
 }
 
+/* put the record built in ctx->rec, the frame of frame_len bytes follows the record header */
+static rt_err_t ctx_put(struct ulog_ctx *ctx, rt_size_t frame_len)
+{
+    struct ulog_ctx_rec *rec = (struct ulog_ctx_rec *) ctx->rec;
+    rt_size_t rec_len = sizeof(struct ulog_ctx_rec) + frame_len;
+
+    /* only this context puts, the space can only grow before the put */
+    if (rt_lfring_space_len(&ctx->ring) < rec_len)
+    {
+        return -RT_EFULL;
+    }
+
+    rec->seq = rt_hw_atomic_add(&ulog.ctx_seq, 1);
+    rec->len = frame_len;
+    rt_lfring_put(&ctx->ring, (const rt_uint8_t *) rec, rec_len);
+    rt_sem_release(&ulog.async_notice);
+
+    return RT_EOK;
+}
+
+/* output the line formatted in the context buffer, through the shared buffer when the ring is full */
+static void ctx_output(struct ulog_ctx *ctx, rt_uint32_t level, const char *tag, rt_size_t log_len)
+{
+    ulog_frame_t log_frame = (ulog_frame_t)((struct ulog_ctx_rec *) ctx->rec + 1);
+
+    log_frame->magic = ULOG_FRAME_MAGIC;
+    log_frame->is_raw = RT_FALSE;
+    log_frame->level = level;
+    log_frame->log_len = log_len;
+    log_frame->tag = tag;
+    /* fixed up by the async output */
+    log_frame->log = NULL;
+
+    if (ctx_put(ctx, sizeof(struct ulog_frame) + log_len) == RT_EOK)
+    {
+        return;
+    }
+
+    ctx->blocked ++;
+    output_lock();
+    if (do_output(level, tag, RT_FALSE, (const char *)(log_frame + 1), log_len) != RT_EOK)
+    {
+        ctx->dropped ++;
+    }
+    output_unlock();
+}
+#endif /* ULOG_USING_CONTEXT_BUF */
+
 /**
  * output the log by variable argument list
  *
@@ -485,6 +722,9 @@ void ulog_voutput(rt_uint32_t level, const char *tag, rt_bool_t newline, const c
 {
     char *log_buf = NULL;
     rt_size_t log_len = 0;
+#ifdef ULOG_USING_CONTEXT_BUF
+    struct ulog_ctx *ctx;
+#endif
 
 #ifndef ULOG_USING_SYSLOG
     RT_ASSERT(level <= LOG_LVL_DBG);
@@ -521,6 +761,37 @@ void ulog_voutput(rt_uint32_t level, const char *tag, rt_bool_t newline, const c
     }
 #endif /* ULOG_USING_FILTER */
 
+#ifdef ULOG_USING_CONTEXT_BUF
+    ctx = get_log_ctx();
+    if (ctx)
+    {
+        /* format in the context buffer, after the record and frame headers */
+        log_buf = (char *)((ulog_frame_t)((struct ulog_ctx_rec *) ctx->rec + 1) + 1);
+
+#ifndef ULOG_USING_SYSLOG
+        log_len = ulog_formater(log_buf, level, tag, newline, format, args);
+#else
+        extern rt_size_t syslog_formater(char *log_buf, rt_uint8_t level, const char *tag, rt_bool_t newline, const char *format, va_list args);
+        log_len = syslog_formater(log_buf, level, tag, newline, format, args);
+#endif /* ULOG_USING_SYSLOG */
+
+#ifdef ULOG_USING_FILTER
+        /* keyword filter */
+        if (ulog.filter.keyword[0] != '\0')
+        {
+            log_buf[log_len] = '\0';
+            if (!rt_strstr(log_buf, ulog.filter.keyword))
+            {
+                return;
+            }
+        }
+#endif /* ULOG_USING_FILTER */
+
+        ctx_output(ctx, level, tag, log_len);
+        return;
+    }
+#endif /* ULOG_USING_CONTEXT_BUF */
+
     /* get log buffer */
     log_buf = get_log_buf();
 
@@ -550,7 +821,16 @@ void ulog_voutput(rt_uint32_t level, const char *tag, rt_bool_t newline, const c
     }
 #endif /* ULOG_USING_FILTER */
     /* do log output */
+#ifdef ULOG_USING_CONTEXT_BUF
+    /* a thread without a context buffer */
+    ulog.other_blocked ++;
+    if (do_output(level, tag, RT_FALSE, log_buf, log_len) != RT_EOK)
+    {
+        ulog.other_dropped ++;
+    }
+#else
     do_output(level, tag, RT_FALSE, log_buf, log_len);
+#endif
 
     /* unlock output */
     output_unlock();
@@ -600,7 +880,7 @@ void ulog_raw(const char *format, ...)
     /* args point to the first variable parameter */
     va_start(args, format);
 
-#ifdef ULOG_OUTPUT_FLOAT
+#if defined(ULOG_OUTPUT_FLOAT) && !defined(RT_PRINTF_FLOAT)
     fmt_result = vsnprintf(log_buf, ULOG_LINE_BUF_SIZE, format, args);
 #else
     fmt_result = rt_vsnprintf(log_buf, ULOG_LINE_BUF_SIZE, format, args);
@@ -625,6 +905,208 @@ void ulog_raw(const char *format, ...)
     output_unlock();
 }
 
+#ifdef ULOG_USING_BINARY
+/**
+ * output the log in the binary mode, only the format address, the tick and the
+ * argument words are stored, the format is deferred to the async output
+ *
+ * @note using the LOG_BIN_X API, it counts the arguments
+ *
+ * @param level level
+ * @param tag tag
+ * @param argc number of the argument words, at most ULOG_BIN_ARGS_MAX
+ * @param format output format, it must be a constant string
+ * @param ... args, integers, characters or pointers to constant strings
+ */
+void ulog_bin_output(rt_uint32_t level, const char *tag, rt_uint32_t argc, const char *format, ...)
+{
+    rt_ubase_t buf[(sizeof(struct ulog_bin_frame) / sizeof(rt_ubase_t)) + ULOG_BIN_ARGS_MAX];
+    ulog_bin_frame_t frame = (ulog_bin_frame_t) buf;
+    rt_size_t frame_len = sizeof(struct ulog_bin_frame) + argc * sizeof(rt_ubase_t);
+    rt_rbb_blk_t log_blk;
+    rt_ubase_t *words;
+    va_list args;
+    rt_uint32_t i;
+#ifdef ULOG_USING_CONTEXT_BUF
+    struct ulog_ctx *ctx;
+#endif
+
+    RT_ASSERT(tag);
+    RT_ASSERT(format);
+    RT_ASSERT(argc <= ULOG_BIN_ARGS_MAX);
+
+    if (!ulog.init_ok)
+    {
+        return;
+    }
+
+#ifdef ULOG_USING_FILTER
+    /* only the global level filter, the others are checked on the output */
+#ifndef ULOG_USING_SYSLOG
+    if (level > ulog.filter.level)
+#else
+    if ((LOG_MASK(LOG_PRI(level)) & ulog.filter.level) == 0)
+#endif /* ULOG_USING_SYSLOG */
+    {
+        return;
+    }
+#endif /* ULOG_USING_FILTER */
+
+    /* package the binary frame */
+    frame->magic = ULOG_BIN_FRAME_MAGIC;
+    frame->level = level;
+    frame->argc = argc;
+    frame->reserved = 0;
+    frame->tick = rt_tick_get();
+    frame->tag = tag;
+    frame->format = format;
+
+    words = (rt_ubase_t *)(frame + 1);
+    va_start(args, format);
+    for (i = 0; i < argc; i++)
+    {
+        words[i] = va_arg(args, rt_ubase_t);
+    }
+    va_end(args);
+
+#ifdef ULOG_USING_CONTEXT_BUF
+    ctx = get_log_ctx();
+    if (ctx)
+    {
+        rt_memcpy((struct ulog_ctx_rec *) ctx->rec + 1, frame, frame_len);
+        if (ctx_put(ctx, frame_len) == RT_EOK)
+        {
+            return;
+        }
+        ctx->blocked ++;
+    }
+    else
+    {
+        rt_hw_atomic_add(&ulog.other_blocked, 1);
+    }
+#endif /* ULOG_USING_CONTEXT_BUF */
+
+    /* the ring block buffer has its own lock, no output lock here */
+    log_blk = rt_rbb_blk_alloc(ulog.async_rbb, RT_ALIGN(frame_len, RT_ALIGN_SIZE));
+    if (log_blk == NULL)
+    {
+        static rt_bool_t already_output = RT_FALSE;
+        if (already_output == RT_FALSE)
+        {
+            rt_kprintf("Warning: There is no enough buffer for saving async log,"
+                    " please increase the ULOG_ASYNC_OUTPUT_BUF_SIZE option.\n");
+            already_output = RT_TRUE;
+        }
+#ifdef ULOG_USING_CONTEXT_BUF
+        if (ctx)
+        {
+            ctx->dropped ++;
+        }
+        else
+        {
+            rt_hw_atomic_add(&ulog.other_dropped, 1);
+        }
+#endif /* ULOG_USING_CONTEXT_BUF */
+        return;
+    }
+
+    rt_memcpy(log_blk->buf, frame, frame_len);
+    rt_rbb_blk_put(log_blk);
+    rt_sem_release(&ulog.async_notice);
+}
+
+static rt_size_t bin_formater(char *log_buf, rt_uint32_t level, const char *tag, const char *format, ...)
+{
+    rt_size_t log_len;
+    va_list args;
+
+    va_start(args, format);
+#ifndef ULOG_USING_SYSLOG
+    log_len = ulog_formater(log_buf, level, tag, RT_TRUE, format, args);
+#else
+    extern rt_size_t syslog_formater(char *log_buf, rt_uint8_t level, const char *tag, rt_bool_t newline, const char *format, va_list args);
+    log_len = syslog_formater(log_buf, level, tag, RT_TRUE, format, args);
+#endif /* ULOG_USING_SYSLOG */
+    va_end(args);
+
+    return log_len;
+}
+
+/* hand the frame to the binary backends and the formatted line to the others */
+static void ulog_bin_output_to_all_backend(ulog_bin_frame_t frame, rt_size_t size)
+{
+    rt_slist_t *node;
+    ulog_backend_t backend;
+    rt_ubase_t words[ULOG_BIN_ARGS_MAX] = { 0 };
+    char *log_buf = NULL;
+    rt_size_t log_len = 0;
+
+#ifdef ULOG_USING_FILTER
+#ifndef ULOG_USING_SYSLOG
+    if (frame->level > ulog_tag_lvl_filter_get(frame->tag))
+#else
+    if ((LOG_MASK(LOG_PRI(frame->level)) & ulog_tag_lvl_filter_get(frame->tag)) == 0)
+#endif /* ULOG_USING_SYSLOG */
+    {
+        return;
+    }
+    else if (!rt_strstr(frame->tag, ulog.filter.tag))
+    {
+        return;
+    }
+#endif /* ULOG_USING_FILTER */
+
+    output_lock();
+
+    for (node = rt_slist_first(&ulog.backend_list); node; node = rt_slist_next(node))
+    {
+        backend = rt_slist_entry(node, struct ulog_backend, list);
+        if (backend->output_bin)
+        {
+            backend->output_bin(backend, frame, size);
+            continue;
+        }
+
+        /* format the line once, on the first backend taking text */
+        if (log_buf == NULL)
+        {
+            rt_memcpy(words, frame + 1, frame->argc * sizeof(rt_ubase_t));
+            log_buf = get_log_buf();
+            if (log_buf == NULL)
+            {
+                break;
+            }
+
+            ulog.bin_tick = frame->tick;
+            ulog.bin_thread = rt_thread_self();
+            /* unused trailing words are zero, the format never reads them */
+            log_len = bin_formater(log_buf, frame->level, frame->tag, frame->format, words[0], words[1],
+                    words[2], words[3], words[4], words[5], words[6], words[7]);
+            ulog.bin_thread = RT_NULL;
+
+#ifdef ULOG_USING_FILTER
+            /* keyword filter */
+            if (ulog.filter.keyword[0] != '\0')
+            {
+                log_buf[log_len] = '\0';
+                if (!rt_strstr(log_buf, ulog.filter.keyword))
+                {
+                    log_len = 0;
+                }
+            }
+#endif /* ULOG_USING_FILTER */
+        }
+
+        if (log_len)
+        {
+            output_to_backend(backend, frame->level, frame->tag, RT_FALSE, log_buf, log_len);
+        }
+    }
+
+    output_unlock();
+}
+#endif /* ULOG_USING_BINARY */
+
 /**
  * dump the hex format data to log
  *
@@ -1151,6 +1633,65 @@ rt_err_t ulog_backend_unregister(ulog_backend_t backend)
 }
 
 #ifdef ULOG_USING_ASYNC_OUTPUT
+#ifdef ULOG_USING_CONTEXT_BUF
+/* output the records of all context rings, the oldest first */
+static void ulog_ctx_output(void)
+{
+    struct ulog_ctx *ctx, *oldest;
+    ulog_frame_t log_frame;
+    int i;
+
+    /* the rings have a single reader, and an ISR can't wait for it */
+    if (rt_interrupt_get_nest() != 0 || rt_mutex_take(&ulog.ctx_locker, RT_WAITING_FOREVER) != RT_EOK)
+    {
+        return;
+    }
+
+    while (1)
+    {
+        oldest = NULL;
+        for (i = 0; i < ULOG_CONTEXT_NUM; i++)
+        {
+            ctx = &ulog.ctx[i];
+            /* a record is put at once, so its header means the whole record */
+            if (!ctx->pending && rt_lfring_data_len(&ctx->ring) >= sizeof(struct ulog_ctx_rec))
+            {
+                rt_lfring_get(&ctx->ring, (rt_uint8_t *) &ctx->pending_rec, sizeof(struct ulog_ctx_rec));
+                ctx->pending = RT_TRUE;
+            }
+
+            if (ctx->pending && (oldest == NULL || (rt_int32_t)(ctx->pending_rec.seq - oldest->pending_rec.seq) < 0))
+            {
+                oldest = ctx;
+            }
+        }
+
+        if (oldest == NULL)
+        {
+            break;
+        }
+
+        rt_lfring_get(&oldest->ring, (rt_uint8_t *) ulog.ctx_out, oldest->pending_rec.len);
+        oldest->pending = RT_FALSE;
+
+        log_frame = (ulog_frame_t) ulog.ctx_out;
+        if (log_frame->magic == ULOG_FRAME_MAGIC)
+        {
+            ulog_output_to_all_backend(log_frame->level, log_frame->tag, log_frame->is_raw, (const char *)(log_frame + 1),
+                    log_frame->log_len);
+        }
+#ifdef ULOG_USING_BINARY
+        else if (log_frame->magic == ULOG_BIN_FRAME_MAGIC)
+        {
+            ulog_bin_output_to_all_backend((ulog_bin_frame_t) ulog.ctx_out, oldest->pending_rec.len);
+        }
+#endif
+    }
+
+    rt_mutex_release(&ulog.ctx_locker);
+}
+#endif /* ULOG_USING_CONTEXT_BUF */
+
 /**
  * asynchronous output logs to all backends
  *
@@ -1161,6 +1702,10 @@ void ulog_async_output(void)
     rt_rbb_blk_t log_blk;
     ulog_frame_t log_frame;
 
+#ifdef ULOG_USING_CONTEXT_BUF
+    ulog_ctx_output();
+#endif
+
     while ((log_blk = rt_rbb_blk_get(ulog.async_rbb)) != NULL)
     {
         log_frame = (ulog_frame_t) log_blk->buf;
@@ -1170,6 +1715,12 @@ void ulog_async_output(void)
             ulog_output_to_all_backend(log_frame->level, log_frame->tag, log_frame->is_raw, log_frame->log,
                     log_frame->log_len);
         }
+#ifdef ULOG_USING_BINARY
+        else if (log_frame->magic == ULOG_BIN_FRAME_MAGIC)
+        {
+            ulog_bin_output_to_all_backend((ulog_bin_frame_t) log_blk->buf, log_blk->size);
+        }
+#endif
         rt_rbb_blk_free(ulog.async_rbb, log_blk);
     }
 }
@@ -1197,6 +1748,38 @@ static void async_output_thread_entry(void *param)
 }
 #endif /* ULOG_USING_ASYNC_OUTPUT */
 
+#if defined(ULOG_USING_CONTEXT_BUF) && defined(RT_USING_FINSH) && defined(FINSH_USING_MSH)
+#include <finsh.h>
+
+static void ulog_ctx(uint8_t argc, char **argv)
+{
+    struct ulog_ctx *ctx;
+    int i;
+
+    rt_kprintf("producer %-*s buffered    dropped    blocked\n", RT_NAME_MAX - 8, "");
+    rt_kprintf("-------- %-*s ---------- ---------- ----------\n", RT_NAME_MAX - 8, "");
+    for (i = 0; i < ULOG_CONTEXT_NUM; i++)
+    {
+        ctx = &ulog.ctx[i];
+        if (i < ULOG_CONTEXT_BUF_NUM)
+        {
+            if (ctx->owner == RT_NULL)
+            {
+                continue;
+            }
+            rt_kprintf("%-*.*s ", RT_NAME_MAX, RT_NAME_MAX, ctx->name);
+        }
+        else
+        {
+            rt_kprintf("ISR%-*d ", RT_NAME_MAX - 3, i - ULOG_CONTEXT_BUF_NUM + 1);
+        }
+        rt_kprintf("%10d %10d %10d\n", rt_lfring_data_len(&ctx->ring), ctx->dropped, ctx->blocked);
+    }
+    rt_kprintf("%-*s %10d %10d %10d\n", RT_NAME_MAX, "others", 0, ulog.other_dropped, ulog.other_blocked);
+}
+MSH_CMD_EXPORT(ulog_ctx, Show ulog context buffers);
+#endif /* defined(ULOG_USING_CONTEXT_BUF) && defined(RT_USING_FINSH) && defined(FINSH_USING_MSH) */
+
 /**
  * flush all backends's log
  */
@@ -1257,6 +1840,20 @@ int ulog_init(void)
     }
 
     rt_sem_init(&ulog.async_notice, "ulog", 0, RT_IPC_FLAG_FIFO);
+
+#ifdef ULOG_USING_CONTEXT_BUF
+    {
+        int i;
+
+        /* a ring must hold the longest log */
+        RT_ASSERT(ULOG_CONTEXT_BUF_SIZE >= ULOG_CONTEXT_REC_MAX);
+        for (i = 0; i < ULOG_CONTEXT_NUM; i++)
+        {
+            rt_lfring_init(&ulog.ctx[i].ring, ulog.ctx[i].pool, ULOG_CONTEXT_BUF_SIZE);
+        }
+        rt_mutex_init(&ulog.ctx_locker, "ulog ctx", RT_IPC_FLAG_FIFO);
+    }
+#endif /* ULOG_USING_CONTEXT_BUF */
     /* async output thread startup */
     rt_thread_startup(ulog.async_th);
 
@@ -1309,6 +1906,10 @@ void ulog_deinit(void)
     rt_thread_delete(ulog.async_th);
 #endif
 
+#ifdef ULOG_USING_CONTEXT_BUF
+    rt_mutex_detach(&ulog.ctx_locker);
+#endif
+
     ulog.init_ok = RT_FALSE;
 }
 
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-08-25     armink       the first version
+ * 2026-10-19     yqiu         add binary log mode
  */
 
 #ifndef _ULOG_H_
@@ -47,6 +48,21 @@ void ulog_deinit(void);
 #define LOG_RAW(...)                   ulog_raw(__VA_ARGS__)
 #define LOG_HEX(name, width, buf, size)      ulog_hex(name, width, buf, size)
 
+/*
+ * output different level log in the binary mode (ULOG_USING_BINARY)
+ *
+ * The caller only stores the format address, the tick and up to 8 argument
+ * words to the async buffer. Formatting is deferred to the async output, or
+ * to the host for the backends taking the binary frames. So the arguments
+ * must be integers, characters or pointers to constant strings, no floats.
+ *
+ * LOG_BIN_I("speed %d, error %d", speed, error);
+ */
+#define LOG_BIN_E(...)                 ulog_bin_e(LOG_TAG, __VA_ARGS__)
+#define LOG_BIN_W(...)                 ulog_bin_w(LOG_TAG, __VA_ARGS__)
+#define LOG_BIN_I(...)                 ulog_bin_i(LOG_TAG, __VA_ARGS__)
+#define LOG_BIN_D(...)                 ulog_bin_d(LOG_TAG, __VA_ARGS__)
+
 /*
  * backend register and unregister
  */
@@ -93,6 +109,10 @@ void ulog_voutput(rt_uint32_t level, const char *tag, rt_bool_t newline, const c
 void ulog_output(rt_uint32_t level, const char *tag, rt_bool_t newline, const char *format, ...);
 void ulog_raw(const char *format, ...);
 
+#ifdef ULOG_USING_BINARY
+void ulog_bin_output(rt_uint32_t level, const char *tag, rt_uint32_t argc, const char *format, ...);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-08-25     armink       the first version
+ * 2026-10-19     yqiu         add binary log mode
  */
 
 #ifndef _ULOG_DEF_H_
@@ -98,6 +99,40 @@ extern "C" {
     #define ulog_e(TAG, ...)
 #endif /* (LOG_LVL >= LOG_LVL_ERROR) && (ULOG_OUTPUT_LVL >= LOG_LVL_ERROR) */
 
+#ifdef ULOG_USING_BINARY
+    /* the number of arguments after the format, at most ULOG_BIN_ARGS_MAX */
+    #define ULOG_BIN_ARGC(...)         _ULOG_BIN_ARGC(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, 0)
+    #define _ULOG_BIN_ARGC(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+    #define ulog_bin(LVL, TAG, ...)    ulog_bin_output(LVL, TAG, ULOG_BIN_ARGC(__VA_ARGS__), __VA_ARGS__)
+#else
+    /* without the binary mode the logs are formatted as usual */
+    #define ulog_bin(LVL, TAG, ...)    ulog_output(LVL, TAG, RT_TRUE, __VA_ARGS__)
+#endif /* ULOG_USING_BINARY */
+
+#if (LOG_LVL >= LOG_LVL_DBG) && (ULOG_OUTPUT_LVL >= LOG_LVL_DBG)
+    #define ulog_bin_d(TAG, ...)       ulog_bin(LOG_LVL_DBG, TAG, __VA_ARGS__)
+#else
+    #define ulog_bin_d(TAG, ...)
+#endif /* (LOG_LVL >= LOG_LVL_DBG) && (ULOG_OUTPUT_LVL >= LOG_LVL_DBG) */
+
+#if (LOG_LVL >= LOG_LVL_INFO) && (ULOG_OUTPUT_LVL >= LOG_LVL_INFO)
+    #define ulog_bin_i(TAG, ...)       ulog_bin(LOG_LVL_INFO, TAG, __VA_ARGS__)
+#else
+    #define ulog_bin_i(TAG, ...)
+#endif /* (LOG_LVL >= LOG_LVL_INFO) && (ULOG_OUTPUT_LVL >= LOG_LVL_INFO) */
+
+#if (LOG_LVL >= LOG_LVL_WARNING) && (ULOG_OUTPUT_LVL >= LOG_LVL_WARNING)
+    #define ulog_bin_w(TAG, ...)       ulog_bin(LOG_LVL_WARNING, TAG, __VA_ARGS__)
+#else
+    #define ulog_bin_w(TAG, ...)
+#endif /* (LOG_LVL >= LOG_LVL_WARNING) && (ULOG_OUTPUT_LVL >= LOG_LVL_WARNING) */
+
+#if (LOG_LVL >= LOG_LVL_ERROR) && (ULOG_OUTPUT_LVL >= LOG_LVL_ERROR)
+    #define ulog_bin_e(TAG, ...)       ulog_bin(LOG_LVL_ERROR, TAG, __VA_ARGS__)
+#else
+    #define ulog_bin_e(TAG, ...)
+#endif /* (LOG_LVL >= LOG_LVL_ERROR) && (ULOG_OUTPUT_LVL >= LOG_LVL_ERROR) */
+
 #if (LOG_LVL >= LOG_LVL_DBG) && (ULOG_OUTPUT_LVL >= LOG_LVL_DBG)
     #define ulog_hex(TAG, width, buf, size)     ulog_hexdump(TAG, width, buf, size)
 #else
@@ -175,6 +210,10 @@ extern "C" {
 #endif
 
 #define ULOG_FRAME_MAGIC               0x10
+#define ULOG_BIN_FRAME_MAGIC           0x11
+
+/* max arguments of a binary log */
+#define ULOG_BIN_ARGS_MAX              8
 
 /* tag's level filter */
 struct ulog_tag_lvl_filter
@@ -197,6 +236,23 @@ struct ulog_frame
 };
 typedef struct ulog_frame *ulog_frame_t;
 
+/*
+ * binary log frame, the format and tag are addresses of the strings in the
+ * firmware image. The argc argument words follow the frame.
+ */
+struct ulog_bin_frame
+{
+    /* magic word is 0x11 */
+    rt_uint32_t magic:8;
+    rt_uint32_t level:8;
+    rt_uint32_t argc:8;
+    rt_uint32_t reserved:8;
+    rt_uint32_t tick;
+    const char *tag;
+    const char *format;
+};
+typedef struct ulog_bin_frame *ulog_bin_frame_t;
+
 struct ulog_backend
 {
     char name[RT_NAME_MAX];
@@ -205,6 +261,8 @@ struct ulog_backend
     void (*output)(struct ulog_backend *backend, rt_uint32_t level, const char *tag, rt_bool_t is_raw, const char *log, size_t len);
     void (*flush) (struct ulog_backend *backend);
     void (*deinit)(struct ulog_backend *backend);
+    /* optional, takes the binary log frames instead of the formatted lines */
+    void (*output_bin)(struct ulog_backend *backend, const struct ulog_bin_frame *frame, size_t len);
     rt_slist_t list;
 };
 typedef struct ulog_backend *ulog_backend_t;
@@ -6,8 +6,10 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-19     MurphyZhao   the first version
+ * 2026-10-19     yqiu         add benchmark mode
  */
 
+#include <rthw.h>
 #include <rtthread.h>
 #include <string.h>
 #include <stdlib.h>
@@ -42,11 +44,30 @@
 #define UTEST_THREAD_PRIORITY   FINSH_THREAD_PRIORITY
 #endif
 
+#ifndef UTEST_BENCH_RUNS
+#define UTEST_BENCH_RUNS        (100)
+#endif
+
+/* the cycle counter is enabled by the Cortex-M4 port */
+#if defined(ARCH_ARM_CORTEX_M4)
+#define UTEST_BENCH_DWT_CYCCNT  (*(volatile rt_uint32_t *)0xE0001004)
+#define UTEST_BENCH_UNIT        "cycles"
+#elif defined(__linux__) || defined(__APPLE__)
+#include <time.h>
+#define UTEST_BENCH_UNIT        "ns"
+#else
+#define UTEST_BENCH_UNIT        "ticks"
+#endif
+
 static rt_uint8_t utest_log_lv = UTEST_LOG_ALL;
 static utest_tc_export_t tc_table = RT_NULL;
 static rt_size_t tc_num;
 static rt_uint32_t tc_loop;
 static struct utest local_utest = {UTEST_PASSED, 0, 0};
+static const char *tc_current = "";
+static rt_uint32_t bench_runs = UTEST_BENCH_RUNS;
+static rt_uint32_t bench_sample;
+static rt_bool_t bench_recorded;
 
 #if defined(__ICCARM__) || defined(__ICCRX__)         /* for IAR compiler */
 #pragma section="UtestTcTab"
@@ -174,6 +195,7 @@ static void utest_run(const char *utest_name)
             is_find = RT_TRUE;
 
             LOG_I("[----------] [ testcase ] (%s) started", tc_table[i].name);
+            tc_current = tc_table[i].name;
             if (tc_table[i].init != RT_NULL)
             {
                 if (tc_table[i].init() != RT_EOK)
@@ -279,6 +301,30 @@ static void utest_testcase_run(int argc, char** argv)
 }
 MSH_CMD_EXPORT_ALIAS(utest_testcase_run, utest_run, utest_run [-thread or -help] [testcase name] [loop num]);
 
+static void utest_bench_testcase_run(int argc, char** argv)
+{
+    static char utest_name[UTEST_NAME_MAX_LEN];
+
+    if (argc < 2 || atoi(argv[1]) <= 0)
+    {
+        rt_kprintf("Usage: utest_bench <runs> [testcase name]\n");
+        return;
+    }
+
+    rt_memset(utest_name, 0x0, sizeof(utest_name));
+    if (argc > 2)
+    {
+        rt_strncpy(utest_name, argv[2], sizeof(utest_name) -1);
+    }
+
+    tc_loop = 1;
+    bench_runs = atoi(argv[1]);
+    rt_kprintf("BENCH,testcase,benchmark,runs,min,median,p99,max,unit\n");
+    utest_run(argc > 2 ? utest_name : RT_NULL);
+    bench_runs = UTEST_BENCH_RUNS;
+}
+MSH_CMD_EXPORT_ALIAS(utest_bench_testcase_run, utest_bench, utest_bench <runs> [testcase name]);
+
 utest_t utest_handle_get(void)
 {
     return (utest_t)&local_utest;
@@ -297,6 +343,91 @@ void utest_unit_run(test_unit_func func, const char *unit_func_name)
     }
 }
 
+rt_uint32_t utest_bench_clock(void)
+{
+#if defined(UTEST_BENCH_DWT_CYCCNT)
+    return UTEST_BENCH_DWT_CYCCNT;
+#elif defined(__linux__) || defined(__APPLE__)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (rt_uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+#else
+    return rt_tick_get();
+#endif
+}
+
+void utest_bench_record(rt_uint32_t elapsed)
+{
+    bench_sample = elapsed;
+    bench_recorded = RT_TRUE;
+}
+
+static int utest_bench_compare(const void *a, const void *b)
+{
+    rt_uint32_t x = *(const rt_uint32_t *)a;
+    rt_uint32_t y = *(const rt_uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+void utest_bench_run(test_unit_func func, const char *bench_name)
+{
+    rt_uint32_t *samples;
+    rt_uint32_t index, start, elapsed;
+
+    local_utest.error = UTEST_PASSED;
+    local_utest.passed_num = 0;
+    local_utest.failed_num = 0;
+
+    if (func == RT_NULL)
+    {
+        return;
+    }
+
+    samples = (rt_uint32_t *)rt_malloc(bench_runs * sizeof(rt_uint32_t));
+    if (samples == RT_NULL)
+    {
+        LOG_E("[  BENCH   ] [ unit     ] (%s) no memory for %d samples", bench_name, bench_runs);
+        local_utest.error = UTEST_FAILED;
+        local_utest.failed_num ++;
+        return;
+    }
+
+#if defined(UTEST_BENCH_DWT_CYCCNT)
+    /* the cycle counter is left running */
+    if (!rt_hw_cycle_counter_enable())
+        LOG_W("[  BENCH   ] [ unit     ] (%s) no cycle counter on this core", bench_name);
+#endif
+
+    /* warm up the caches and the lazy initialization of the kernel */
+    func();
+
+    for (index = 0; index < bench_runs && local_utest.failed_num == 0; index ++)
+    {
+        bench_recorded = RT_FALSE;
+        start = utest_bench_clock();
+        func();
+        elapsed = utest_bench_clock() - start;
+
+        samples[index] = bench_recorded ? bench_sample : elapsed;
+    }
+
+    if (local_utest.failed_num == 0)
+    {
+        qsort(samples, bench_runs, sizeof(rt_uint32_t), utest_bench_compare);
+
+        LOG_I("[  BENCH   ] [ unit     ] (%s) min %u, median %u, p99 %u, max %u %s", bench_name,
+              samples[0], samples[bench_runs / 2], samples[(bench_runs * 99 + 99) / 100 - 1],
+              samples[bench_runs - 1], UTEST_BENCH_UNIT);
+        rt_kprintf("BENCH,%s,%s,%u,%u,%u,%u,%u,%s\n", tc_current, bench_name, bench_runs,
+                   samples[0], samples[bench_runs / 2], samples[(bench_runs * 99 + 99) / 100 - 1],
+                   samples[bench_runs - 1], UTEST_BENCH_UNIT);
+    }
+
+    rt_free(samples);
+}
+
 void utest_assert(int value, const char *file, int line, const char *func, const char *msg)
 {
     if (!(value))
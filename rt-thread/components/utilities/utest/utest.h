@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-19     MurphyZhao   the first version
+ * 2026-10-19     yqiu         add benchmark mode
  */
 
 #ifndef __UTEST_H__
@@ -157,4 +158,63 @@ utest_t utest_handle_get(void);
     utest_unit_run(test_unit_func, #test_unit_func);                           \
     if(utest_handle_get()->failed_num != 0) return;
 
+/**
+ * utest_bench_clock
+ * 
+ * @brief Read the benchmark clock: the DWT cycle counter on Cortex-M4,
+ *        nanoseconds in a host build, OS ticks otherwise.
+ * 
+ * @param void
+ * 
+ * @return The current clock value.
+ * 
+*/
+rt_uint32_t utest_bench_clock(void);
+
+/**
+ * utest_bench_record
+ * 
+ * @brief Record the sample of the current benchmark run, instead of the time
+ *        of the whole benchmark function. For times measured across threads
+ *        or interrupts, e.g. a wakeup latency.
+ * 
+ * @param elapsed The elapsed clock of this run.
+ * 
+ * @return void
+ * 
+*/
+void utest_bench_record(rt_uint32_t elapsed);
+
+/**
+ * utest_bench_run
+ * 
+ * @brief Benchmark function executor.
+ *        No need for the user to call this function directly
+ * 
+ * @param func       Benchmark function, one call is one run.
+ * @param bench_name Benchmark function name.
+ * 
+ * @return void
+ * 
+*/
+void utest_bench_run(test_unit_func func, const char *bench_name);
+
+/**
+ * UTEST_BENCH_RUN
+ * 
+ * @brief Benchmark function executor.
+ *        Used in `testcase` function in application. The function is called
+ *        once to warm up and then N times, N is set by `utest_bench`. The
+ *        min, median, p99 and max of the samples are printed as a line
+ *        "BENCH,testcase,benchmark,runs,min,median,p99,max,unit".
+ * 
+ * @param bench_func Benchmark function
+ * 
+ * @return None
+ * 
+*/
+#define UTEST_BENCH_RUN(bench_func)                                            \
+    utest_bench_run(bench_func, #bench_func);                                  \
+    if(utest_handle_get()->failed_num != 0) return;
+
 #endif /* __UTEST_H__ */
@@ -183,7 +183,7 @@ typedef int (*init_fn_t)(void);
 #ifdef _MSC_VER /* we do not support MS VC++ compiler */
     #define INIT_EXPORT(fn, level)
 #else
-    #if RT_DEBUG_INIT
+    #if RT_DEBUG_INIT || defined(RT_USING_INIT_PROFILE)
         struct rt_init_desc
         {
             const char* fn_name;
@@ -217,6 +217,25 @@ typedef int (*init_fn_t)(void);
 /* appliation initialization (rtgui application etc ...) */
 #define INIT_APP_EXPORT(fn)             INIT_EXPORT(fn, "6")
 
+/*
+ * asynchronous initialization: fn is handed to the init worker threads at the
+ * given level and runs as soon as the asynchronous init functions named in
+ * depends (separated by ',', or RT_NULL) are done, e.g.
+ *     INIT_ASYNC_EXPORT(sensor_init, "5", "qspi_init");
+ */
+#if defined(RT_USING_INIT_ASYNC) && !defined(_MSC_VER)
+#define INIT_ASYNC_EXPORT(fn, level, depends)                                    \
+    static struct rt_init_async __rti_async_##fn =                               \
+    { {RT_NULL, RT_NULL}, #fn, fn, depends, 0, 0 };                              \
+    static int __rti_async_##fn##_submit(void)                                   \
+    {                                                                            \
+        return rt_components_async_submit(&__rti_async_##fn);                    \
+    }                                                                            \
+    INIT_EXPORT(__rti_async_##fn##_submit, level)
+#else
+#define INIT_ASYNC_EXPORT(fn, level, depends)   INIT_EXPORT(fn, level)
+#endif
+
 #if !defined(RT_USING_FINSH)
 /* define these to empty, even if not include finsh.h file */
 #define FINSH_FUNCTION_EXPORT(name, desc)
@@ -316,6 +335,23 @@ struct rt_slist_node
 };
 typedef struct rt_slist_node rt_slist_t;                /**< Type for single list. */
 
+#ifdef RT_USING_INIT_ASYNC
+/**
+ * Asynchronous initialization entry, see INIT_ASYNC_EXPORT
+ */
+struct rt_init_async
+{
+    rt_list_t list;
+
+    const char *fn_name;
+    int (*fn)(void);
+    const char *depends;                                /**< names of the init functions it waits for */
+
+    rt_uint8_t state;
+    int result;
+};
+#endif
+
 /**
  * @addtogroup KernelObject
  */
@@ -606,7 +642,7 @@ struct rt_semaphore
     struct rt_ipc_object parent;                        /**< inherit from ipc_object */
 
     rt_uint16_t          value;                         /**< value of semaphore. */
-    rt_uint16_t          reserved;                      /**< reserved field */
+    rt_uint16_t          reserved;                      /**< non-zero while threads may be suspended */
 };
 typedef struct rt_semaphore *rt_sem_t;
 #endif
@@ -627,6 +663,19 @@ struct rt_mutex
     struct rt_thread    *owner;                         /**< current owner of mutex */
 };
 typedef struct rt_mutex *rt_mutex_t;
+
+/*
+ * With the atomic fast path, the lowest bit of the owner pointer marks that
+ * threads may be suspended on the mutex, so that an unlocking owner has to
+ * take the slow path. Use RT_MUTEX_OWNER() to get the owner thread.
+ */
+#ifdef RT_USING_HW_ATOMIC
+#define RT_MUTEX_HAS_WAITERS            0x01
+#else
+#define RT_MUTEX_HAS_WAITERS            0x00
+#endif
+#define RT_MUTEX_OWNER(mutex)           \
+    ((struct rt_thread *)((rt_ubase_t)(mutex)->owner & ~(rt_ubase_t)RT_MUTEX_HAS_WAITERS))
 #endif
 
 #ifdef RT_USING_EVENT
@@ -764,6 +813,42 @@ struct rt_mempool
     rt_size_t        suspend_thread_count;              /**< numbers of thread pended on this resource */
 };
 typedef struct rt_mempool *rt_mp_t;
+
+#ifdef RT_USING_MEMPOOL_MAGAZINE
+#ifndef RT_MP_MAGAZINE_SIZE
+#define RT_MP_MAGAZINE_SIZE             8
+#endif
+
+#ifndef RT_MP_SIZECLASS_MAX
+#define RT_MP_SIZECLASS_MAX             4
+#endif
+
+/**
+ * A few blocks of a memory pool cached for one thread, or for the interrupts
+ */
+struct rt_mp_magazine
+{
+    rt_mp_t          mp;                                /**< pool the blocks belong to */
+    rt_thread_t      owner;                             /**< owner thread, RT_NULL for interrupts */
+
+    rt_uint16_t      count;                             /**< numbers of cached block */
+    void            *blocks[RT_MP_MAGAZINE_SIZE];       /**< cached blocks */
+
+    rt_uint32_t      refill_count;                      /**< batch refills from the pool */
+    rt_uint32_t      drain_count;                       /**< batch drains to the pool */
+};
+typedef struct rt_mp_magazine *rt_mp_magazine_t;
+
+/**
+ * Memory pools of increasing block size for small fixed-size objects
+ */
+struct rt_mp_sizeclass
+{
+    rt_uint8_t       class_num;                         /**< numbers of size class */
+    rt_mp_t          pools[RT_MP_SIZECLASS_MAX];        /**< pools by increasing block size */
+};
+typedef struct rt_mp_sizeclass *rt_mp_sizeclass_t;
+#endif
 #endif
 
 /**@}*/
@@ -117,6 +117,29 @@ void rt_hw_exception_install(rt_err_t (*exception_handle)(void *context));
  */
 void rt_hw_us_delay(rt_uint32_t us);
 
+/*
+ * cycle counter interfaces, provided by the Cortex-M4 port
+ */
+rt_bool_t rt_hw_cycle_counter_enable(void);
+
+/*
+ * atomic interfaces, with exclusive access instructions on cores that have
+ * them (RT_USING_HW_ATOMIC) or an interrupt disabled fallback otherwise
+ */
+rt_uint32_t rt_hw_atomic_cas(volatile rt_uint32_t *ptr, rt_uint32_t expected, rt_uint32_t desired);
+rt_uint32_t rt_hw_atomic_add(volatile rt_uint32_t *ptr, rt_int32_t value);
+void rt_hw_dmb(void);
+
+#ifdef RT_USING_HW_MEMCPY
+/*
+ * memory copy and set interfaces of the CPU port, behind rt_memcpy,
+ * rt_memmove and rt_memset
+ */
+void *rt_hw_memcpy(void *dst, const void *src, rt_ubase_t count);
+void *rt_hw_memmove(void *dst, const void *src, rt_ubase_t count);
+void *rt_hw_memset(void *s, int c, rt_ubase_t count);
+#endif
+
 #define RT_DEFINE_SPINLOCK(x)  
 #define RT_DECLARE_SPINLOCK(x)    rt_ubase_t x
 
@@ -227,6 +227,23 @@ rt_err_t rt_mp_delete(rt_mp_t mp);
 void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time);
 void rt_mp_free(void *block);
 
+#ifdef RT_USING_MEMPOOL_MAGAZINE
+void rt_mp_magazine_init(rt_mp_magazine_t mag, rt_mp_t mp, rt_thread_t owner);
+void rt_mp_magazine_flush(rt_mp_magazine_t mag);
+void *rt_mp_magazine_alloc(rt_mp_magazine_t mag, rt_int32_t time);
+void rt_mp_magazine_free(rt_mp_magazine_t mag, void *block);
+
+#ifdef RT_USING_HEAP
+rt_err_t rt_mp_sizeclass_create(rt_mp_sizeclass_t sc,
+                                const char       *name,
+                                const rt_size_t  *block_size,
+                                const rt_size_t  *block_count,
+                                rt_uint8_t        class_num);
+rt_err_t rt_mp_sizeclass_delete(rt_mp_sizeclass_t sc);
+void *rt_mp_sizeclass_alloc(rt_mp_sizeclass_t sc, rt_size_t size, rt_int32_t time);
+#endif
+#endif
+
 #ifdef RT_USING_HOOK
 void rt_mp_alloc_sethook(void (*hook)(struct rt_mempool *mp, void *block));
 void rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block));
@@ -275,6 +292,10 @@ rt_err_t rt_memheap_detach(struct rt_memheap *heap);
 void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size);
 void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize);
 void rt_memheap_free(void *ptr);
+
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+void *rt_malloc_region(const char *region, rt_size_t size);
+#endif
 #endif
 
 /**@}*/
@@ -380,6 +401,11 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
                     rt_size_t  size,
                     rt_int32_t timeout);
 rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg);
+
+void *rt_mq_loan(rt_mq_t mq);
+rt_err_t rt_mq_commit(rt_mq_t mq, void *buffer);
+rt_err_t rt_mq_recv_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer);
 #endif
 
 /**@}*/
@@ -452,8 +478,19 @@ void rt_interrupt_leave_sethook(void (*hook)(void));
 #ifdef RT_USING_COMPONENTS_INIT
 void rt_components_init(void);
 void rt_components_board_init(void);
+
+#ifdef RT_USING_INIT_PROFILE
+void rt_components_boot_mark(const char *name);
+#endif
+
+#ifdef RT_USING_INIT_ASYNC
+int rt_components_async_submit(struct rt_init_async *entry);
+rt_err_t rt_components_async_wait(rt_int32_t timeout);
+#endif
 #endif
 
+rt_uint32_t rt_hw_boot_time_us(void);
+
 /**
  * @addtogroup KernelService
  */
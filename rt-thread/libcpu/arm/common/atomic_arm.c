@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version, LDREX/STREX for ARMv7-M
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+
+#ifdef RT_USING_HW_ATOMIC
+
+/**
+ * This function compares the word at ptr with expected and, only if they are
+ * equal, stores desired to it, as one atomic operation.
+ *
+ * @return the value of the word before the operation; the store took place
+ * when it equals expected.
+ */
+#if defined(__CC_ARM) || defined(__CLANG_ARM)
+__asm rt_uint32_t rt_hw_atomic_cas(volatile rt_uint32_t *ptr, rt_uint32_t expected, rt_uint32_t desired)
+{
+retry
+    LDREX   r3, [r0]
+    CMP     r3, r1
+    BNE     mismatch
+    STREX   r12, r2, [r0]
+    CMP     r12, #0x00
+    BNE     retry
+    DMB
+    MOV     r0, r3
+    BX      lr
+
+mismatch
+    CLREX
+    MOV     r0, r3
+    BX      lr
+}
+
+__asm rt_uint32_t rt_hw_atomic_add(volatile rt_uint32_t *ptr, rt_int32_t value)
+{
+retry
+    LDREX   r2, [r0]
+    ADD     r2, r2, r1
+    STREX   r3, r2, [r0]
+    CMP     r3, #0x00
+    BNE     retry
+    DMB
+    MOV     r0, r2
+    BX      lr
+}
+
+__asm void rt_hw_dmb(void)
+{
+    DMB
+    BX      lr
+}
+#elif defined(__IAR_SYSTEMS_ICC__) || defined(__GNUC__)
+rt_uint32_t rt_hw_atomic_cas(volatile rt_uint32_t *ptr, rt_uint32_t expected, rt_uint32_t desired)
+{
+    rt_uint32_t old, fail;
+
+    do
+    {
+        asm volatile ("LDREX %0, [%1]" : "=r"(old) : "r"(ptr) : "memory");
+        if (old != expected)
+        {
+            asm volatile ("CLREX" : : : "memory");
+            return old;
+        }
+        asm volatile ("STREX %0, %2, [%1]" : "=&r"(fail) : "r"(ptr), "r"(desired) : "memory");
+    } while (fail);
+
+    asm volatile ("DMB" : : : "memory");
+
+    return old;
+}
+
+rt_uint32_t rt_hw_atomic_add(volatile rt_uint32_t *ptr, rt_int32_t value)
+{
+    rt_uint32_t result, fail;
+
+    do
+    {
+        asm volatile ("LDREX %0, [%1]" : "=r"(result) : "r"(ptr) : "memory");
+        result += value;
+        asm volatile ("STREX %0, %2, [%1]" : "=&r"(fail) : "r"(ptr), "r"(result) : "memory");
+    } while (fail);
+
+    asm volatile ("DMB" : : : "memory");
+
+    return result;
+}
+
+void rt_hw_dmb(void)
+{
+    asm volatile ("DMB" : : : "memory");
+}
+#endif
+
+#endif /* RT_USING_HW_ATOMIC */
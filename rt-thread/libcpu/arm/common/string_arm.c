@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-19     yqiu         first version, LDM/STM bursts for ARMv7-M
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+
+#ifdef RT_USING_HW_MEMCPY
+
+/*
+ * Memory copy and set for ARMv7-M. The destination is word aligned first,
+ * then a word aligned source is moved in 32 byte LDM/STM bursts and a
+ * misaligned one is merged from aligned source words with shifts. The
+ * backward copy of rt_hw_memmove loads misaligned source words directly,
+ * which ARMv7-M allows for LDR but not for LDM.
+ */
+
+#define BURST_SIZE      32
+
+#if defined(__CC_ARM)
+#define LOAD_UNALIGNED(p)   (*(__packed rt_uint32_t *)(p))
+
+__asm static void copy_burst(rt_uint32_t *dst, const rt_uint32_t *src, rt_ubase_t size)
+{
+    PUSH    {r4-r6, r8-r10}
+loop
+    LDMIA   r1!, {r3-r6, r8-r10, r12}
+    STMIA   r0!, {r3-r6, r8-r10, r12}
+    SUBS    r2, r2, #32
+    BNE     loop
+    POP     {r4-r6, r8-r10}
+    BX      lr
+}
+
+/* dst and src point to the end of the block */
+__asm static void copy_burst_backward(rt_uint32_t *dst, const rt_uint32_t *src, rt_ubase_t size)
+{
+    PUSH    {r4-r6, r8-r10}
+loop
+    LDMDB   r1!, {r3-r6, r8-r10, r12}
+    STMDB   r0!, {r3-r6, r8-r10, r12}
+    SUBS    r2, r2, #32
+    BNE     loop
+    POP     {r4-r6, r8-r10}
+    BX      lr
+}
+
+__asm static void set_burst(rt_uint32_t *dst, rt_uint32_t word, rt_ubase_t size)
+{
+    PUSH    {r4-r6, r8-r10}
+    MOV     r3, r1
+    MOV     r4, r1
+    MOV     r5, r1
+    MOV     r6, r1
+    MOV     r8, r1
+    MOV     r9, r1
+    MOV     r10, r1
+loop
+    STMIA   r0!, {r1, r3-r6, r8-r10}
+    SUBS    r2, r2, #32
+    BNE     loop
+    POP     {r4-r6, r8-r10}
+    BX      lr
+}
+#elif defined(__GNUC__)
+rt_inline rt_uint32_t LOAD_UNALIGNED(const rt_uint8_t *p)
+{
+    rt_uint32_t word;
+
+    asm ("LDR %0, [%1]" : "=r"(word) : "r"(p), "m"(*(const rt_uint8_t (*)[4])p));
+
+    return word;
+}
+
+rt_inline void copy_burst(rt_uint32_t *dst, const rt_uint32_t *src, rt_ubase_t size)
+{
+    asm volatile (
+        "1:                                 \n"
+        "LDMIA  %1!, {r3-r6, r8-r10, r12}   \n"
+        "STMIA  %0!, {r3-r6, r8-r10, r12}   \n"
+        "SUBS   %2, %2, #32                 \n"
+        "BNE    1b                          \n"
+        : "+r"(dst), "+r"(src), "+r"(size)
+        :
+        : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+}
+
+/* dst and src point to the end of the block */
+rt_inline void copy_burst_backward(rt_uint32_t *dst, const rt_uint32_t *src, rt_ubase_t size)
+{
+    asm volatile (
+        "1:                                 \n"
+        "LDMDB  %1!, {r3-r6, r8-r10, r12}   \n"
+        "STMDB  %0!, {r3-r6, r8-r10, r12}   \n"
+        "SUBS   %2, %2, #32                 \n"
+        "BNE    1b                          \n"
+        : "+r"(dst), "+r"(src), "+r"(size)
+        :
+        : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+}
+
+rt_inline void set_burst(rt_uint32_t *dst, rt_uint32_t word, rt_ubase_t size)
+{
+    asm volatile (
+        "MOV    r3, %2                      \n"
+        "MOV    r4, %2                      \n"
+        "MOV    r5, %2                      \n"
+        "MOV    r6, %2                      \n"
+        "MOV    r8, %2                      \n"
+        "MOV    r9, %2                      \n"
+        "MOV    r10, %2                     \n"
+        "MOV    r12, %2                     \n"
+        "1:                                 \n"
+        "STMIA  %0!, {r3-r6, r8-r10, r12}   \n"
+        "SUBS   %1, %1, #32                 \n"
+        "BNE    1b                          \n"
+        : "+r"(dst), "+r"(size)
+        : "r"(word)
+        : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+}
+#elif defined(__IAR_SYSTEMS_ICC__)
+#define LOAD_UNALIGNED(p)   (*(__packed rt_uint32_t *)(p))
+
+/* the compiler makes LDM/STM of the unrolled words */
+static void copy_burst(rt_uint32_t *dst, const rt_uint32_t *src, rt_ubase_t size)
+{
+    for (; size; size -= BURST_SIZE, dst += 8, src += 8)
+    {
+        dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3];
+        dst[4] = src[4]; dst[5] = src[5]; dst[6] = src[6]; dst[7] = src[7];
+    }
+}
+
+static void copy_burst_backward(rt_uint32_t *dst, const rt_uint32_t *src, rt_ubase_t size)
+{
+    for (; size; size -= BURST_SIZE)
+    {
+        dst -= 8;
+        src -= 8;
+        dst[7] = src[7]; dst[6] = src[6]; dst[5] = src[5]; dst[4] = src[4];
+        dst[3] = src[3]; dst[2] = src[2]; dst[1] = src[1]; dst[0] = src[0];
+    }
+}
+
+static void set_burst(rt_uint32_t *dst, rt_uint32_t word, rt_ubase_t size)
+{
+    for (; size; size -= BURST_SIZE, dst += 8)
+    {
+        dst[0] = word; dst[1] = word; dst[2] = word; dst[3] = word;
+        dst[4] = word; dst[5] = word; dst[6] = word; dst[7] = word;
+    }
+}
+#endif
+
+/* shift is the source misalignment in bits, a constant in each expansion */
+#define MERGE_WORDS(shift)                                              \
+    do                                                                  \
+    {                                                                   \
+        while (n >= 4)                                                  \
+        {                                                               \
+            next = *sw++;                                               \
+            *dw++ = (cur >> (shift)) | (next << (32 - (shift)));        \
+            cur = next;                                                 \
+            n -= 4;                                                     \
+        }                                                               \
+    } while (0)
+
+/* the destination may be below an overlapping source */
+static void copy_forward(rt_uint8_t *d, const rt_uint8_t *s, rt_ubase_t n)
+{
+    rt_uint32_t *dw;
+    const rt_uint32_t *sw;
+    rt_uint32_t cur, next;
+    rt_ubase_t burst;
+
+    if (n >= 8)
+    {
+        while ((rt_ubase_t)d & 3)
+        {
+            *d++ = *s++;
+            n--;
+        }
+
+        dw = (rt_uint32_t *)d;
+        if (((rt_ubase_t)s & 3) == 0)
+        {
+            sw = (const rt_uint32_t *)s;
+            burst = n & ~(BURST_SIZE - 1);
+            if (burst)
+            {
+                copy_burst(dw, sw, burst);
+                dw += burst / 4;
+                sw += burst / 4;
+                n -= burst;
+            }
+            while (n >= 4)
+            {
+                *dw++ = *sw++;
+                n -= 4;
+            }
+        }
+        else
+        {
+            /* each aligned source word is loaded once, never past the last byte's word */
+            sw = (const rt_uint32_t *)((rt_ubase_t)s & ~3);
+            cur = *sw++;
+            switch ((rt_ubase_t)s & 3)
+            {
+            case 1:
+                MERGE_WORDS(8);
+                break;
+            case 2:
+                MERGE_WORDS(16);
+                break;
+            default:
+                MERGE_WORDS(24);
+                break;
+            }
+        }
+
+        s += (rt_uint8_t *)dw - d;
+        d = (rt_uint8_t *)dw;
+    }
+
+    while (n--)
+        *d++ = *s++;
+}
+
+/* the destination may be above an overlapping source */
+static void copy_backward(rt_uint8_t *d, const rt_uint8_t *s, rt_ubase_t n)
+{
+    rt_uint32_t *dw;
+    const rt_uint32_t *sw;
+    const rt_uint8_t *sp;
+    rt_ubase_t burst;
+
+    d += n;
+    s += n;
+    if (n >= 8)
+    {
+        while ((rt_ubase_t)d & 3)
+        {
+            *--d = *--s;
+            n--;
+        }
+
+        dw = (rt_uint32_t *)d;
+        if (((rt_ubase_t)s & 3) == 0)
+        {
+            sw = (const rt_uint32_t *)s;
+            burst = n & ~(BURST_SIZE - 1);
+            if (burst)
+            {
+                copy_burst_backward(dw, sw, burst);
+                dw -= burst / 4;
+                sw -= burst / 4;
+                n -= burst;
+            }
+            while (n >= 4)
+            {
+                *--dw = *--sw;
+                n -= 4;
+            }
+        }
+        else
+        {
+            for (sp = s; n >= 4; n -= 4)
+            {
+                sp -= 4;
+                *--dw = LOAD_UNALIGNED(sp);
+            }
+        }
+
+        s -= d - (rt_uint8_t *)dw;
+        d = (rt_uint8_t *)dw;
+    }
+
+    while (n--)
+        *--d = *--s;
+}
+
+/**
+ * This function copies count bytes from src to dst, which shall not overlap
+ * unless dst is below src.
+ *
+ * @return the address of destination memory
+ */
+void *rt_hw_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    copy_forward((rt_uint8_t *)dst, (const rt_uint8_t *)src, count);
+
+    return dst;
+}
+
+/**
+ * This function copies count bytes from src to dst, which may overlap.
+ *
+ * @return the address of destination memory
+ */
+void *rt_hw_memmove(void *dst, const void *src, rt_ubase_t count)
+{
+    if ((rt_ubase_t)dst - (rt_ubase_t)src >= count)
+        copy_forward((rt_uint8_t *)dst, (const rt_uint8_t *)src, count);
+    else if (dst != src)
+        copy_backward((rt_uint8_t *)dst, (const rt_uint8_t *)src, count);
+
+    return dst;
+}
+
+/**
+ * This function sets count bytes at s to the value c.
+ *
+ * @return the address of source memory
+ */
+void *rt_hw_memset(void *s, int c, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)s;
+    rt_uint32_t *dw;
+    rt_uint32_t word;
+    rt_ubase_t burst;
+
+    if (count >= 8)
+    {
+        word = c & 0xff;
+        word |= word << 8;
+        word |= word << 16;
+
+        while ((rt_ubase_t)d & 3)
+        {
+            *d++ = (rt_uint8_t)c;
+            count--;
+        }
+
+        dw = (rt_uint32_t *)d;
+        burst = count & ~(BURST_SIZE - 1);
+        if (burst)
+        {
+            set_burst(dw, word, burst);
+            dw += burst / 4;
+            count -= burst;
+        }
+        while (count >= 4)
+        {
+            *dw++ = word;
+            count -= 4;
+        }
+        d = (rt_uint8_t *)dw;
+    }
+
+    while (count--)
+        *d++ = (rt_uint8_t)c;
+
+    return s;
+}
+
+#endif /* RT_USING_HW_MEMCPY */
@@ -14,6 +14,7 @@
  * 2012-12-29     Bernard      Add exception hook.
  * 2013-06-23     aozima       support lazy stack optimized.
  * 2018-07-24     aozima       enhancement hard fault exception handler.
+ * 2026-10-19     yqiu         add rt_hw_cycle_counter_enable.
  */
 
 #include <rtthread.h>
@@ -442,6 +443,29 @@ RT_WEAK void rt_hw_cpu_reset(void)
     SCB_AIRCR = SCB_RESET_VALUE;
 }
 
+#define DEBUG_DEMCR         (*(volatile unsigned long *)0xE000EDFC)  /* Debug Exception and Monitor Control Register */
+#define DEBUG_DEMCR_TRCENA  (1UL << 24)                               /* Enable DWT and ITM */
+#define DWT_CTRL            (*(volatile unsigned long *)0xE0001000)  /* DWT Control Register */
+#define DWT_CTRL_NOCYCCNT   (1UL << 25)                               /* No cycle counter implemented */
+#define DWT_CTRL_CYCCNTENA  (1UL << 0)                                /* Enable the cycle counter */
+
+/**
+ * enable the DWT cycle counter, it is left running
+ *
+ * @return RT_TRUE if the core implements the cycle counter
+ */
+rt_bool_t rt_hw_cycle_counter_enable(void)
+{
+    /* the DWT registers are only accessible with trace enabled */
+    DEBUG_DEMCR |= DEBUG_DEMCR_TRCENA;
+    if (DWT_CTRL & DWT_CTRL_NOCYCCNT)
+        return RT_FALSE;
+
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+
+    return RT_TRUE;
+}
+
 #ifdef RT_USING_CPU_FFS
 /**
  * This function finds the first bit set (beginning with the least significant bit)
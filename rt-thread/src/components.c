@@ -14,6 +14,7 @@
  * 2015-05-04     Bernard      Rename it to components.c because compiling issue
  *                             in some IDEs.
  * 2015-07-29     Arda.Fu      Add support to use RT_USING_USER_MAIN with IAR
+ * 2026-10-19     yqiu         Add boot time profiling and asynchronous initialization
  */
 
 #include <rthw.h>
@@ -76,19 +77,351 @@ static int rti_end(void)
 }
 INIT_EXPORT(rti_end, "6.end");
 
+/**
+ * This function returns the microseconds since the board initialization. A
+ * BSP should override it with a finer clock than the OS tick.
+ */
+RT_WEAK rt_uint32_t rt_hw_boot_time_us(void)
+{
+    return rt_tick_get() * (1000000 / RT_TICK_PER_SECOND);
+}
+
+#ifdef RT_USING_INIT_PROFILE
+#ifndef RT_INIT_PROFILE_MAX
+#define RT_INIT_PROFILE_MAX     64
+#endif
+
+#define RT_INIT_RECORD_ASYNC    0x01
+#define RT_INIT_RECORD_MARK     0x02
+
+struct rt_init_record
+{
+    const char *name;
+    rt_uint32_t start;                  /* us since the board initialization */
+    rt_uint32_t time;
+    int result;
+    rt_uint8_t flag;
+};
+
+static struct rt_init_record init_records[RT_INIT_PROFILE_MAX];
+static rt_uint16_t init_record_num, init_record_missed;
+
+static void _init_record(const char *name, rt_uint32_t start, int result, rt_uint8_t flag)
+{
+    register rt_base_t level;
+    rt_uint32_t now = rt_hw_boot_time_us();
+
+    level = rt_hw_interrupt_disable();
+    if (init_record_num < RT_INIT_PROFILE_MAX)
+    {
+        init_records[init_record_num].name   = name;
+        init_records[init_record_num].start  = start;
+        init_records[init_record_num].time   = now - start;
+        init_records[init_record_num].result = result;
+        init_records[init_record_num].flag   = flag;
+        init_record_num ++;
+    }
+    else
+    {
+        init_record_missed ++;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will record and report a boot milestone, such as the first
+ * cycle of a control loop.
+ *
+ * @param name the name of the milestone
+ */
+void rt_components_boot_mark(const char *name)
+{
+    rt_uint32_t now = rt_hw_boot_time_us();
+
+    _init_record(name, now, 0, RT_INIT_RECORD_MARK);
+    rt_kprintf("[boot] %s at %d us\n", name, now);
+}
+#endif
+
+#if RT_DEBUG_INIT || defined(RT_USING_INIT_PROFILE)
+static void _init_call(const struct rt_init_desc *desc)
+{
+    int result;
+#ifdef RT_USING_INIT_PROFILE
+    rt_uint32_t start = rt_hw_boot_time_us();
+#endif
+
+#if RT_DEBUG_INIT
+    rt_kprintf("initialize %s", desc->fn_name);
+#endif
+    result = desc->fn();
+#if RT_DEBUG_INIT
+    rt_kprintf(":%d done\n", result);
+#endif
+
+#ifdef RT_USING_INIT_PROFILE
+    _init_record(desc->fn_name, start, result, 0);
+#endif
+}
+#endif
+
+#ifdef RT_USING_INIT_ASYNC
+#ifndef RT_INIT_ASYNC_WORKERS
+#define RT_INIT_ASYNC_WORKERS       2
+#endif
+#ifndef RT_INIT_ASYNC_STACK_SIZE
+#define RT_INIT_ASYNC_STACK_SIZE    2048
+#endif
+#ifndef RT_INIT_ASYNC_PRIORITY
+#define RT_INIT_ASYNC_PRIORITY      (RT_THREAD_PRIORITY_MAX - 8)
+#endif
+
+#define RT_INIT_ASYNC_PENDING       0
+#define RT_INIT_ASYNC_RUNNING       1
+#define RT_INIT_ASYNC_DONE          2
+
+#define RT_INIT_EVENT_WAKE          0x01
+#define RT_INIT_EVENT_DONE          0x02
+
+static rt_list_t async_list = RT_LIST_OBJECT_INIT(async_list);
+static struct rt_event async_event;
+static rt_bool_t async_inited = RT_FALSE;
+static rt_bool_t async_closed = RT_FALSE;
+static rt_uint8_t async_workers, async_running;
+
+/* whether the async entry named name..name+len is done, in critical section */
+static rt_bool_t _async_depend_done(const char *name, rt_size_t len)
+{
+    struct rt_list_node *node;
+    struct rt_init_async *entry;
+
+    rt_list_for_each(node, &async_list)
+    {
+        entry = rt_list_entry(node, struct rt_init_async, list);
+        if (rt_strncmp(entry->fn_name, name, len) == 0 && entry->fn_name[len] == '\0')
+            return entry->state == RT_INIT_ASYNC_DONE;
+    }
+
+    /* not submitted (yet), it will not come once all levels are done */
+    return async_closed;
+}
+
+static rt_bool_t _async_runnable(struct rt_init_async *entry)
+{
+    const char *name, *end;
+
+    if (entry->state != RT_INIT_ASYNC_PENDING)
+        return RT_FALSE;
+
+    for (name = entry->depends; name != RT_NULL && *name != '\0'; name = end)
+    {
+        while (*name == ',' || *name == ' ')
+            name ++;
+        for (end = name; *end != '\0' && *end != ',' && *end != ' '; end ++);
+
+        if (end != name && !_async_depend_done(name, end - name))
+            return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
+/* the next entry to run, in critical section */
+static struct rt_init_async *_async_next(rt_bool_t *finished)
+{
+    struct rt_list_node *node;
+    struct rt_init_async *entry, *pending = RT_NULL;
+
+    rt_list_for_each(node, &async_list)
+    {
+        entry = rt_list_entry(node, struct rt_init_async, list);
+        if (_async_runnable(entry))
+            return entry;
+        if (pending == RT_NULL && entry->state == RT_INIT_ASYNC_PENDING)
+            pending = entry;
+    }
+
+    *finished = (async_closed && pending == RT_NULL && async_running == 0);
+    if (async_closed && pending != RT_NULL && async_running == 0)
+    {
+        /* nothing can make progress: the dependencies are circular */
+        rt_kprintf("[boot] %s: circular init dependency, run anyway\n", pending->fn_name);
+        return pending;
+    }
+
+    return RT_NULL;
+}
+
+static void _async_worker_entry(void *parameter)
+{
+    struct rt_init_async *entry;
+    rt_bool_t finished = RT_FALSE, last;
+    rt_uint32_t recved;
+#ifdef RT_USING_INIT_PROFILE
+    rt_uint32_t start;
+#endif
+
+    while (1)
+    {
+        rt_enter_critical();
+        entry = _async_next(&finished);
+        if (entry != RT_NULL)
+        {
+            entry->state = RT_INIT_ASYNC_RUNNING;
+            async_running ++;
+        }
+        rt_exit_critical();
+
+        if (entry != RT_NULL)
+        {
+#ifdef RT_USING_INIT_PROFILE
+            start = rt_hw_boot_time_us();
+#endif
+            entry->result = entry->fn();
+#ifdef RT_USING_INIT_PROFILE
+            _init_record(entry->fn_name, start, entry->result, RT_INIT_RECORD_ASYNC);
+#endif
+
+            rt_enter_critical();
+            entry->state = RT_INIT_ASYNC_DONE;
+            async_running --;
+            rt_exit_critical();
+
+            /* its dependents may run now */
+            rt_event_send(&async_event, RT_INIT_EVENT_WAKE);
+            continue;
+        }
+
+        if (finished)
+            break;
+
+        rt_event_recv(&async_event, RT_INIT_EVENT_WAKE, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      RT_WAITING_FOREVER, &recved);
+    }
+
+    rt_enter_critical();
+    last = (-- async_workers == 0);
+    rt_exit_critical();
+
+    if (last)
+    {
+#ifdef RT_USING_INIT_PROFILE
+        rt_kprintf("[boot] async init done at %d us\n", rt_hw_boot_time_us());
+#endif
+        rt_event_send(&async_event, RT_INIT_EVENT_DONE);
+    }
+    else
+    {
+        /* let the other workers see that all is done */
+        rt_event_send(&async_event, RT_INIT_EVENT_WAKE);
+    }
+}
+
+static void _async_init(void)
+{
+    if (async_inited == RT_FALSE)
+    {
+        rt_event_init(&async_event, "rti", RT_IPC_FLAG_FIFO);
+        async_inited = RT_TRUE;
+    }
+}
+
+/**
+ * This function will hand an asynchronous init entry to the init workers,
+ * it is called by the function generated by INIT_ASYNC_EXPORT.
+ *
+ * @param entry the asynchronous init entry
+ *
+ * @return 0 on submitted, or the result of the init function when it had to
+ *         run synchronously
+ */
+int rt_components_async_submit(struct rt_init_async *entry)
+{
+    rt_thread_t tid;
+    char name[RT_NAME_MAX];
+
+    RT_ASSERT(entry != RT_NULL);
+
+    _async_init();
+
+    rt_enter_critical();
+    entry->state = RT_INIT_ASYNC_PENDING;
+    rt_list_insert_before(&async_list, &(entry->list));
+    rt_exit_critical();
+
+    /* the workers are created with the first entry */
+    while (async_workers < RT_INIT_ASYNC_WORKERS)
+    {
+        rt_snprintf(name, RT_NAME_MAX, "tinit%d", async_workers);
+        tid = rt_thread_create(name, _async_worker_entry, RT_NULL,
+                               RT_INIT_ASYNC_STACK_SIZE, RT_INIT_ASYNC_PRIORITY, 20);
+        if (tid == RT_NULL)
+            break;
+
+        async_workers ++;
+        rt_thread_startup(tid);
+    }
+
+    if (async_workers == 0)
+    {
+        /* no worker, run it here */
+        rt_enter_critical();
+        rt_list_remove(&(entry->list));
+        rt_exit_critical();
+
+        entry->result = entry->fn();
+        entry->state = RT_INIT_ASYNC_DONE;
+        return entry->result;
+    }
+
+    rt_event_send(&async_event, RT_INIT_EVENT_WAKE);
+
+    return 0;
+}
+
+/* all levels are done, no more entries will be submitted */
+static void _async_close(void)
+{
+    _async_init();
+
+    rt_enter_critical();
+    async_closed = RT_TRUE;
+    rt_exit_critical();
+
+    if (async_workers == 0)
+        rt_event_send(&async_event, RT_INIT_EVENT_DONE);
+    else
+        rt_event_send(&async_event, RT_INIT_EVENT_WAKE);
+}
+
+/**
+ * This function will wait until all asynchronous init functions are done.
+ *
+ * @param timeout the waiting time
+ *
+ * @return RT_EOK, or -RT_ETIMEOUT
+ */
+rt_err_t rt_components_async_wait(rt_int32_t timeout)
+{
+    rt_uint32_t recved;
+
+    _async_init();
+
+    return rt_event_recv(&async_event, RT_INIT_EVENT_DONE, RT_EVENT_FLAG_OR,
+                         timeout, &recved);
+}
+#endif
+
 /**
  * RT-Thread Components Initialization for board
  */
 void rt_components_board_init(void)
 {
-#if RT_DEBUG_INIT
-    int result;
+#if RT_DEBUG_INIT || defined(RT_USING_INIT_PROFILE)
     const struct rt_init_desc *desc;
     for (desc = &__rt_init_desc_rti_board_start; desc < &__rt_init_desc_rti_board_end; desc ++)
     {
-        rt_kprintf("initialize %s", desc->fn_name);
-        result = desc->fn();
-        rt_kprintf(":%d done\n", result);
+        _init_call(desc);
     }
 #else
     const init_fn_t *fn_ptr;
@@ -105,16 +438,15 @@ void rt_components_board_init(void)
  */
 void rt_components_init(void)
 {
-#if RT_DEBUG_INIT
-    int result;
+#if RT_DEBUG_INIT || defined(RT_USING_INIT_PROFILE)
     const struct rt_init_desc *desc;
 
+#if RT_DEBUG_INIT
     rt_kprintf("do components initialization.\n");
+#endif
     for (desc = &__rt_init_desc_rti_board_end; desc < &__rt_init_desc_rti_end; desc ++)
     {
-        rt_kprintf("initialize %s", desc->fn_name);
-        result = desc->fn();
-        rt_kprintf(":%d done\n", result);
+        _init_call(desc);
     }
 #else
     const init_fn_t *fn_ptr;
@@ -124,8 +456,44 @@ void rt_components_init(void)
         (*fn_ptr)();
     }
 #endif
+
+#ifdef RT_USING_INIT_ASYNC
+    _async_close();
+#endif
+
+#ifdef RT_USING_INIT_PROFILE
+    rt_kprintf("[boot] components initialized at %d us\n", rt_hw_boot_time_us());
+#endif
 }
 
+#if defined(RT_USING_INIT_PROFILE) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+static void list_init(void)
+{
+    rt_uint16_t index;
+    struct rt_init_record *record;
+
+    rt_kprintf("init function        start(us) time(us)   result\n");
+    rt_kprintf("-------------------- ---------- ---------- ------\n");
+    for (index = 0; index < init_record_num; index ++)
+    {
+        record = &init_records[index];
+        if (record->flag & RT_INIT_RECORD_MARK)
+        {
+            rt_kprintf("%-20.20s %-10d (boot milestone)\n", record->name, record->start);
+            continue;
+        }
+
+        rt_kprintf("%-20.20s %-10d %-10d %d%s\n", record->name, record->start, record->time,
+                   record->result, (record->flag & RT_INIT_RECORD_ASYNC) ? " async" : "");
+    }
+    if (init_record_missed)
+        rt_kprintf("%d records missed\n", init_record_missed);
+}
+MSH_CMD_EXPORT(list_init, list the time of the initialization functions);
+#endif
+
 #ifdef RT_USING_USER_MAIN
 
 void rt_application_init(void);
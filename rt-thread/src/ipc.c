@@ -32,6 +32,8 @@
  * 2010-11-10     Bernard      add IPC reset command implementation.
  * 2011-12-18     Bernard      add more parameter checking in message queue
  * 2013-09-14     Grissiom     add an option check in rt_event_recv
+ * 2026-10-19     yqiu         add loan/commit zero-copy message queue interface
+ * 2026-10-19     yqiu         add uncontended atomic fast path to semaphore and mutex
  */
 
 #include <rtthread.h>
@@ -183,6 +185,54 @@ rt_inline rt_err_t rt_ipc_list_resume_all(rt_list_t *list)
 }
 
 #ifdef RT_USING_SEMAPHORE
+#ifdef RT_USING_HW_ATOMIC
+/*
+ * The value and reserved halfwords of a semaphore are accessed as one word by
+ * the fast path, value in the low half (the CPU is little-endian). The slow
+ * path sets reserved before it suspends a thread, so that a concurrent fast
+ * release fails its compare-and-swap and wakes the thread up instead. Any
+ * interrupt or context switch clears the exclusive monitor, so the slow path
+ * needs no atomic instructions as long as interrupts are disabled.
+ */
+#define RT_SEM_WORD(sem)        ((volatile rt_uint32_t *)&((sem)->value))
+#define RT_SEM_VALUE_MASK       0xffffU
+
+rt_inline rt_bool_t _rt_sem_take_fast(rt_sem_t sem)
+{
+    rt_uint32_t word, old;
+
+    word = *RT_SEM_WORD(sem);
+    while (word & RT_SEM_VALUE_MASK)
+    {
+        old = rt_hw_atomic_cas(RT_SEM_WORD(sem), word, word - 1);
+        if (old == word)
+            return RT_TRUE;
+
+        word = old;
+    }
+
+    return RT_FALSE;
+}
+
+rt_inline rt_bool_t _rt_sem_release_fast(rt_sem_t sem)
+{
+    rt_uint32_t word, old;
+
+    /* nobody suspended and value does not overflow into reserved */
+    word = *RT_SEM_WORD(sem);
+    while (word < RT_SEM_VALUE_MASK)
+    {
+        old = rt_hw_atomic_cas(RT_SEM_WORD(sem), word, word + 1);
+        if (old == word)
+            return RT_TRUE;
+
+        word = old;
+    }
+
+    return RT_FALSE;
+}
+#endif
+
 /**
  * This function will initialize a semaphore and put it under control of
  * resource management.
@@ -210,6 +260,7 @@ rt_err_t rt_sem_init(rt_sem_t    sem,
 
     /* set init value */
     sem->value = (rt_uint16_t)value;
+    sem->reserved = 0;
 
     /* set parent */
     sem->parent.parent.flag = flag;
@@ -273,6 +324,7 @@ rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag)
 
     /* set init value */
     sem->value = value;
+    sem->reserved = 0;
 
     /* set parent */
     sem->parent.parent.flag = flag;
@@ -330,6 +382,15 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
 
     RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(sem->parent.parent)));
 
+#ifdef RT_USING_HW_ATOMIC
+    if (_rt_sem_take_fast(sem))
+    {
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(sem->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif
+
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
@@ -370,6 +431,9 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
             RT_DEBUG_LOG(RT_DEBUG_IPC, ("sem take: suspend thread - %s\n",
                                         thread->name));
 
+            /* force releasing threads onto the slow path */
+            sem->reserved = 1;
+
             /* suspend thread */
             rt_ipc_list_suspend(&(sem->parent.suspend_thread),
                                 thread,
@@ -439,6 +503,11 @@ rt_err_t rt_sem_release(rt_sem_t sem)
 
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(sem->parent.parent)));
 
+#ifdef RT_USING_HW_ATOMIC
+    if (_rt_sem_release_fast(sem))
+        return RT_EOK;
+#endif
+
     need_schedule = RT_FALSE;
 
     /* disable interrupt */
@@ -458,6 +527,10 @@ rt_err_t rt_sem_release(rt_sem_t sem)
     else
         sem->value ++; /* increase value */
 
+    /* the last waiter is gone (or timed out), allow the fast path again */
+    if (rt_list_isempty(&sem->parent.suspend_thread))
+        sem->reserved = 0;
+
     /* enable interrupt */
     rt_hw_interrupt_enable(temp);
 
@@ -500,6 +573,7 @@ rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg)
 
         /* set new value */
         sem->value = (rt_uint16_t)value;
+        sem->reserved = 0;
 
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
@@ -515,6 +589,76 @@ RTM_EXPORT(rt_sem_control);
 #endif /* end of RT_USING_SEMAPHORE */
 
 #ifdef RT_USING_MUTEX
+#ifdef RT_USING_HW_ATOMIC
+/*
+ * An unowned mutex is taken by swapping its owner from RT_NULL to the current
+ * thread. The slow path decides availability on the owner as well and sets
+ * RT_MUTEX_HAS_WAITERS in it before suspending a thread, after raising the
+ * owner's priority, so an owner with waiters always releases through the slow
+ * path and priority inheritance is undone there.
+ */
+#define RT_MUTEX_WORD(mutex)    ((volatile rt_uint32_t *)&((mutex)->owner))
+
+rt_inline rt_bool_t _rt_mutex_take_fast(rt_mutex_t mutex, struct rt_thread *thread)
+{
+    rt_uint8_t priority;
+
+    /* recursive take, hold is only written by the owner */
+    if (RT_MUTEX_OWNER(mutex) == thread)
+    {
+        mutex->hold ++;
+
+        return RT_TRUE;
+    }
+
+    /* sample the priority before a contender can see us as owner and raise it */
+    priority = thread->current_priority;
+    if (rt_hw_atomic_cas(RT_MUTEX_WORD(mutex), (rt_uint32_t)RT_NULL, (rt_uint32_t)thread) != (rt_uint32_t)RT_NULL)
+        return RT_FALSE;
+
+    mutex->value             = 0;
+    mutex->original_priority = priority;
+    mutex->hold              = 1;
+
+    return RT_TRUE;
+}
+
+rt_inline rt_bool_t _rt_mutex_release_fast(rt_mutex_t mutex, struct rt_thread *thread)
+{
+    rt_uint8_t priority;
+
+    /* not the owner, or threads are waiting */
+    if (mutex->owner != thread)
+        return RT_FALSE;
+
+    if (mutex->hold > 1)
+    {
+        mutex->hold --;
+
+        return RT_TRUE;
+    }
+
+    /* the priority was changed while holding the mutex */
+    priority = mutex->original_priority;
+    if (priority != thread->current_priority)
+        return RT_FALSE;
+
+    /* free the mutex before dropping the owner, and restore it when a
+     * contender has flagged the owner meanwhile */
+    mutex->hold              = 0;
+    mutex->value             = 1;
+    mutex->original_priority = 0xff;
+    if (rt_hw_atomic_cas(RT_MUTEX_WORD(mutex), (rt_uint32_t)thread, (rt_uint32_t)RT_NULL) == (rt_uint32_t)thread)
+        return RT_TRUE;
+
+    mutex->hold              = 1;
+    mutex->value             = 0;
+    mutex->original_priority = priority;
+
+    return RT_FALSE;
+}
+#endif
+
 /**
  * This function will initialize a mutex and put it under control of resource
  * management.
@@ -664,11 +808,22 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
     /* get current thread */
     thread = rt_thread_self();
 
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
+
+#ifdef RT_USING_HW_ATOMIC
+    if (_rt_mutex_take_fast(mutex, thread))
+    {
+        thread->error = RT_EOK;
+
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mutex->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif
+
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
-    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
-
     RT_DEBUG_LOG(RT_DEBUG_IPC,
                  ("mutex_take: current thread %s, mutex value: %d, hold: %d\n",
                   thread->name, mutex->value, mutex->hold));
@@ -676,7 +831,7 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
     /* reset thread error */
     thread->error = RT_EOK;
 
-    if (mutex->owner == thread)
+    if (RT_MUTEX_OWNER(mutex) == thread)
     {
         /* it's the same thread */
         mutex->hold ++;
@@ -684,10 +839,11 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
     else
     {
 __again:
-        /* The value of mutex is 1 in initial status. Therefore, if the
-         * value is great than 0, it indicates the mutex is avaible.
+        /* The owner of mutex is RT_NULL in initial status. The fast path
+         * claims the owner before it updates value, so the owner, not the
+         * value, indicates the mutex is avaible.
          */
-        if (mutex->value > 0)
+        if (mutex->owner == RT_NULL)
         {
             /* mutex is available */
             mutex->value --;
@@ -717,14 +873,17 @@ __again:
                                             thread->name));
 
                 /* change the owner thread priority of mutex */
-                if (thread->current_priority < mutex->owner->current_priority)
+                if (thread->current_priority < RT_MUTEX_OWNER(mutex)->current_priority)
                 {
                     /* change the owner thread priority */
-                    rt_thread_control(mutex->owner,
+                    rt_thread_control(RT_MUTEX_OWNER(mutex),
                                       RT_THREAD_CTRL_CHANGE_PRIORITY,
                                       &thread->current_priority);
                 }
 
+                /* force the owner onto the slow path when it releases */
+                mutex->owner = (struct rt_thread *)((rt_ubase_t)mutex->owner | RT_MUTEX_HAS_WAITERS);
+
                 /* suspend current thread */
                 rt_ipc_list_suspend(&(mutex->parent.suspend_thread),
                                     thread,
@@ -803,6 +962,13 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     /* get current thread */
     thread = rt_thread_self();
 
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mutex->parent.parent)));
+
+#ifdef RT_USING_HW_ATOMIC
+    if (_rt_mutex_release_fast(mutex, thread))
+        return RT_EOK;
+#endif
+
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
@@ -810,10 +976,8 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
                  ("mutex_release:current thread %s, mutex value: %d, hold: %d\n",
                   thread->name, mutex->value, mutex->hold));
 
-    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mutex->parent.parent)));
-
     /* mutex only can be released by owner */
-    if (thread != mutex->owner)
+    if (thread != RT_MUTEX_OWNER(mutex))
     {
         thread->error = -RT_ERROR;
 
@@ -829,9 +993,9 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     if (mutex->hold == 0)
     {
         /* change the owner thread to original priority */
-        if (mutex->original_priority != mutex->owner->current_priority)
+        if (mutex->original_priority != thread->current_priority)
         {
-            rt_thread_control(mutex->owner,
+            rt_thread_control(thread,
                               RT_THREAD_CTRL_CHANGE_PRIORITY,
                               &(mutex->original_priority));
         }
@@ -855,6 +1019,10 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
             /* resume thread */
             rt_ipc_list_resume(&(mutex->parent.suspend_thread));
 
+            /* keep the new owner on the slow path while others still wait */
+            if (!rt_list_isempty(&mutex->parent.suspend_thread))
+                mutex->owner = (struct rt_thread *)((rt_ubase_t)thread | RT_MUTEX_HAS_WAITERS);
+
             need_schedule = RT_TRUE;
         }
         else
@@ -1763,6 +1931,218 @@ struct rt_mq_message
     struct rt_mq_message *next;
 };
 
+/*
+ * take a free message from the free list, or RT_NULL when the queue is full
+ */
+rt_inline struct rt_mq_message *_rt_mq_alloc(rt_mq_t mq)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    msg = (struct rt_mq_message *)mq->msg_queue_free;
+    /* move free list pointer */
+    if (msg != RT_NULL)
+        mq->msg_queue_free = msg->next;
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return msg;
+}
+
+/*
+ * put a message back to the free list
+ */
+rt_inline void _rt_mq_free(rt_mq_t mq, struct rt_mq_message *msg)
+{
+    register rt_ubase_t temp;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    msg->next = (struct rt_mq_message *)mq->msg_queue_free;
+    mq->msg_queue_free = msg;
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+}
+
+/*
+ * link a filled message to the tail of the queue and wake up a receiver
+ */
+static void _rt_mq_enqueue(rt_mq_t mq, struct rt_mq_message *msg)
+{
+    register rt_ubase_t temp;
+
+    /* the msg is the new tailer of list, the next shall be NULL */
+    msg->next = RT_NULL;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    /* link msg to message queue */
+    if (mq->msg_queue_tail != RT_NULL)
+    {
+        /* if the tail exists, */
+        ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
+    }
+
+    /* set new tail */
+    mq->msg_queue_tail = msg;
+    /* if the head is empty, set head */
+    if (mq->msg_queue_head == RT_NULL)
+        mq->msg_queue_head = msg;
+
+    /* increase message entry */
+    mq->entry ++;
+
+    /* resume suspended thread */
+    if (!rt_list_isempty(&mq->parent.suspend_thread))
+    {
+        rt_ipc_list_resume(&(mq->parent.suspend_thread));
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        rt_schedule();
+
+        return;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+}
+
+/*
+ * wait for a message and unlink it from the head of the queue
+ */
+static rt_err_t _rt_mq_dequeue(rt_mq_t mq, rt_int32_t timeout, struct rt_mq_message **msg_ptr)
+{
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+    rt_uint32_t tick_delta;
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* for non-blocking call */
+    if (mq->entry == 0 && timeout == 0)
+    {
+        rt_hw_interrupt_enable(temp);
+
+        return -RT_ETIMEOUT;
+    }
+
+    /* message queue is empty */
+    while (mq->entry == 0)
+    {
+        RT_DEBUG_IN_THREAD_CONTEXT;
+
+        /* reset error number in thread */
+        thread->error = RT_EOK;
+
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            thread->error = -RT_ETIMEOUT;
+
+            return -RT_ETIMEOUT;
+        }
+
+        /* suspend current thread */
+        rt_ipc_list_suspend(&(mq->parent.suspend_thread),
+                            thread,
+                            mq->parent.parent.flag);
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("set thread:%s to timer list\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* recv message */
+        if (thread->error != RT_EOK)
+        {
+            /* return error */
+            return thread->error;
+        }
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    /* get message from queue */
+    msg = (struct rt_mq_message *)mq->msg_queue_head;
+
+    /* move message queue head */
+    mq->msg_queue_head = msg->next;
+    /* reach queue tail, set to NULL */
+    if (mq->msg_queue_tail == msg)
+        mq->msg_queue_tail = RT_NULL;
+
+    /* decrease message entry */
+    mq->entry --;
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    *msg_ptr = msg;
+
+    return RT_EOK;
+}
+
+/*
+ * get the message owning a loaned buffer
+ */
+rt_inline struct rt_mq_message *_rt_mq_loan_msg(rt_mq_t mq, void *buffer)
+{
+    struct rt_mq_message *msg = (struct rt_mq_message *)buffer - 1;
+
+    /* the buffer must be the payload of one message in the pool */
+    RT_ASSERT((rt_uint8_t *)msg >= (rt_uint8_t *)mq->msg_pool);
+    RT_ASSERT((rt_uint8_t *)msg < (rt_uint8_t *)mq->msg_pool +
+              mq->max_msgs * (mq->msg_size + sizeof(struct rt_mq_message)));
+    RT_ASSERT(((rt_uint8_t *)msg - (rt_uint8_t *)mq->msg_pool) %
+              (mq->msg_size + sizeof(struct rt_mq_message)) == 0);
+
+    return msg;
+}
+
 /**
  * This function will initialize a message queue and put it under control of
  * resource management.
@@ -1961,7 +2341,6 @@ RTM_EXPORT(rt_mq_delete);
  */
 rt_err_t rt_mq_send(rt_mq_t mq, void *buffer, rt_size_t size)
 {
-    register rt_ubase_t temp;
     struct rt_mq_message *msg;
 
     /* parameter check */
@@ -1976,63 +2355,16 @@ rt_err_t rt_mq_send(rt_mq_t mq, void *buffer, rt_size_t size)
 
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
 
-    /* disable interrupt */
-    temp = rt_hw_interrupt_disable();
-
     /* get a free list, there must be an empty item */
-    msg = (struct rt_mq_message *)mq->msg_queue_free;
+    msg = _rt_mq_alloc(mq);
     /* message queue is full */
     if (msg == RT_NULL)
-    {
-        /* enable interrupt */
-        rt_hw_interrupt_enable(temp);
-
         return -RT_EFULL;
-    }
-    /* move free list pointer */
-    mq->msg_queue_free = msg->next;
-
-    /* enable interrupt */
-    rt_hw_interrupt_enable(temp);
 
-    /* the msg is the new tailer of list, the next shall be NULL */
-    msg->next = RT_NULL;
     /* copy buffer */
     rt_memcpy(msg + 1, buffer, size);
 
-    /* disable interrupt */
-    temp = rt_hw_interrupt_disable();
-    /* link msg to message queue */
-    if (mq->msg_queue_tail != RT_NULL)
-    {
-        /* if the tail exists, */
-        ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
-    }
-
-    /* set new tail */
-    mq->msg_queue_tail = msg;
-    /* if the head is empty, set head */
-    if (mq->msg_queue_head == RT_NULL)
-        mq->msg_queue_head = msg;
-
-    /* increase message entry */
-    mq->entry ++;
-
-    /* resume suspended thread */
-    if (!rt_list_isempty(&mq->parent.suspend_thread))
-    {
-        rt_ipc_list_resume(&(mq->parent.suspend_thread));
-
-        /* enable interrupt */
-        rt_hw_interrupt_enable(temp);
-
-        rt_schedule();
-
-        return RT_EOK;
-    }
-
-    /* enable interrupt */
-    rt_hw_interrupt_enable(temp);
+    _rt_mq_enqueue(mq, msg);
 
     return RT_EOK;
 }
@@ -2066,24 +2398,11 @@ rt_err_t rt_mq_urgent(rt_mq_t mq, void *buffer, rt_size_t size)
 
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
 
-    /* disable interrupt */
-    temp = rt_hw_interrupt_disable();
-
     /* get a free list, there must be an empty item */
-    msg = (struct rt_mq_message *)mq->msg_queue_free;
+    msg = _rt_mq_alloc(mq);
     /* message queue is full */
     if (msg == RT_NULL)
-    {
-        /* enable interrupt */
-        rt_hw_interrupt_enable(temp);
-
         return -RT_EFULL;
-    }
-    /* move free list pointer */
-    mq->msg_queue_free = msg->next;
-
-    /* enable interrupt */
-    rt_hw_interrupt_enable(temp);
 
     /* copy buffer */
     rt_memcpy(msg + 1, buffer, size);
@@ -2139,10 +2458,8 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
                     rt_size_t  size,
                     rt_int32_t timeout)
 {
-    struct rt_thread *thread;
-    register rt_ubase_t temp;
+    rt_err_t result;
     struct rt_mq_message *msg;
-    rt_uint32_t tick_delta;
 
     /* parameter check */
     RT_ASSERT(mq != RT_NULL);
@@ -2150,120 +2467,127 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
     RT_ASSERT(buffer != RT_NULL);
     RT_ASSERT(size != 0);
 
-    /* initialize delta tick */
-    tick_delta = 0;
-    /* get current thread */
-    thread = rt_thread_self();
-    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
-
-    /* disable interrupt */
-    temp = rt_hw_interrupt_disable();
-
-    /* for non-blocking call */
-    if (mq->entry == 0 && timeout == 0)
-    {
-        rt_hw_interrupt_enable(temp);
-
-        return -RT_ETIMEOUT;
-    }
-
-    /* message queue is empty */
-    while (mq->entry == 0)
-    {
-        RT_DEBUG_IN_THREAD_CONTEXT;
+    result = _rt_mq_dequeue(mq, timeout, &msg);
+    if (result != RT_EOK)
+        return result;
 
-        /* reset error number in thread */
-        thread->error = RT_EOK;
+    /* copy message */
+    rt_memcpy(buffer, msg + 1, size > mq->msg_size ? mq->msg_size : size);
 
-        /* no waiting, return timeout */
-        if (timeout == 0)
-        {
-            /* enable interrupt */
-            rt_hw_interrupt_enable(temp);
+    /* put message to free list */
+    _rt_mq_free(mq, msg);
 
-            thread->error = -RT_ETIMEOUT;
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
 
-            return -RT_ETIMEOUT;
-        }
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_recv);
 
-        /* suspend current thread */
-        rt_ipc_list_suspend(&(mq->parent.suspend_thread),
-                            thread,
-                            mq->parent.parent.flag);
+/**
+ * This function will loan a free message buffer of the message queue to the
+ * caller, which fills the message in place and publishes it with
+ * rt_mq_commit, or gives it back unused with rt_mq_release.
+ *
+ * @param mq the message queue object
+ *
+ * @return the message buffer of msg_size bytes, RT_NULL if the queue is full
+ */
+void *rt_mq_loan(rt_mq_t mq)
+{
+    struct rt_mq_message *msg;
 
-        /* has waiting time, start thread timer */
-        if (timeout > 0)
-        {
-            /* get the start tick of timer */
-            tick_delta = rt_tick_get();
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
 
-            RT_DEBUG_LOG(RT_DEBUG_IPC, ("set thread:%s to timer list\n",
-                                        thread->name));
+    msg = _rt_mq_alloc(mq);
+    if (msg == RT_NULL)
+        return RT_NULL;
 
-            /* reset the timeout of thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &timeout);
-            rt_timer_start(&(thread->thread_timer));
-        }
+    return msg + 1;
+}
+RTM_EXPORT(rt_mq_loan);
 
-        /* enable interrupt */
-        rt_hw_interrupt_enable(temp);
+/**
+ * This function will publish a message buffer loaned by rt_mq_loan to the
+ * tail of the message queue without copying it. If there are threads
+ * suspended on message queue object, it will be waked up.
+ *
+ * @param mq the message queue object
+ * @param buffer the loaned message buffer
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_commit(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
 
-        /* re-schedule */
-        rt_schedule();
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
 
-        /* recv message */
-        if (thread->error != RT_EOK)
-        {
-            /* return error */
-            return thread->error;
-        }
+    _rt_mq_enqueue(mq, _rt_mq_loan_msg(mq, buffer));
 
-        /* disable interrupt */
-        temp = rt_hw_interrupt_disable();
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_commit);
 
-        /* if it's not waiting forever and then re-calculate timeout tick */
-        if (timeout > 0)
-        {
-            tick_delta = rt_tick_get() - tick_delta;
-            timeout -= tick_delta;
-            if (timeout < 0)
-                timeout = 0;
-        }
-    }
+/**
+ * This function will receive a message from message queue object without
+ * copying it, if there is no message in message queue object, the thread
+ * shall wait for a specified time. The message buffer stays owned by the
+ * caller until it is given back with rt_mq_release.
+ *
+ * @param mq the message queue object
+ * @param buffer the address of the received message buffer will be saved in
+ * @param timeout the waiting time
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_recv_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    rt_err_t result;
+    struct rt_mq_message *msg;
 
-    /* get message from queue */
-    msg = (struct rt_mq_message *)mq->msg_queue_head;
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
 
-    /* move message queue head */
-    mq->msg_queue_head = msg->next;
-    /* reach queue tail, set to NULL */
-    if (mq->msg_queue_tail == msg)
-        mq->msg_queue_tail = RT_NULL;
+    result = _rt_mq_dequeue(mq, timeout, &msg);
+    if (result != RT_EOK)
+        return result;
 
-    /* decrease message entry */
-    mq->entry --;
+    *buffer = msg + 1;
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(temp);
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
 
-    /* copy message */
-    rt_memcpy(buffer, msg + 1, size > mq->msg_size ? mq->msg_size : size);
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_recv_loan);
 
-    /* disable interrupt */
-    temp = rt_hw_interrupt_disable();
-    /* put message to free list */
-    msg->next = (struct rt_mq_message *)mq->msg_queue_free;
-    mq->msg_queue_free = msg;
-    /* enable interrupt */
-    rt_hw_interrupt_enable(temp);
+/**
+ * This function will give a message buffer back to the message queue, either
+ * one received with rt_mq_recv_loan or one loaned but never committed.
+ *
+ * @param mq the message queue object
+ * @param buffer the message buffer
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
 
-    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+    _rt_mq_free(mq, _rt_mq_loan_msg(mq, buffer));
 
     return RT_EOK;
 }
-RTM_EXPORT(rt_mq_recv);
+RTM_EXPORT(rt_mq_release);
 
 /**
  * This function can get or set some extra attributions of a message queue
@@ -17,6 +17,9 @@
  * 2013-06-24     Bernard      remove rt_kprintf if RT_USING_CONSOLE is not defined.
  * 2013-09-24     aozima       make sure the device is in STREAM mode when used by rt_kprintf.
  * 2015-07-06     Bernard      Add rt_assert_handler routine.
+ * 2026-10-19     yqiu         add interrupt disabled fallback of the atomic interfaces.
+ * 2026-10-19     yqiu         add float number support to rt_vsnprintf.
+ * 2026-10-19     yqiu         use the memory copy and set of the CPU port if any.
  */
 
 #include <rtthread.h>
@@ -125,7 +128,9 @@ RTM_EXPORT(_rt_errno);
  */
 void *rt_memset(void *s, int c, rt_ubase_t count)
 {
-#ifdef RT_USING_TINY_SIZE
+#if defined(RT_USING_HW_MEMCPY)
+    return rt_hw_memset(s, c, count);
+#elif defined(RT_USING_TINY_SIZE)
     char *xs = (char *)s;
 
     while (count--)
@@ -209,7 +214,9 @@ RTM_EXPORT(rt_memset);
  */
 void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
 {
-#ifdef RT_USING_TINY_SIZE
+#if defined(RT_USING_HW_MEMCPY)
+    return rt_hw_memcpy(dst, src, count);
+#elif defined(RT_USING_TINY_SIZE)
     char *tmp = (char *)dst, *s = (char *)src;
     rt_ubase_t len;
 
@@ -292,6 +299,9 @@ RTM_EXPORT(rt_memcpy);
  */
 void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
 {
+#ifdef RT_USING_HW_MEMCPY
+    return rt_hw_memmove(dest, src, n);
+#else
     char *tmp = (char *)dest, *s = (char *)src;
 
     if (s < tmp && tmp < s + n)
@@ -304,11 +314,12 @@ void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
     }
     else
     {
-        while (n--)
-            *tmp++ = *s++;
+        /* rt_memcpy copies forward, a destination below the source is safe */
+        return rt_memcpy(dest, src, n);
     }
 
     return dest;
+#endif
 }
 RTM_EXPORT(rt_memmove);
 
@@ -774,6 +785,463 @@ static char *print_number(char *buf,
     return buf;
 }
 
+#ifdef RT_PRINTF_FLOAT
+/* fraction digits made from the binary value, a higher precision pads zeros */
+#define FLOAT_DIGITS_MAX    20
+/* integer digits, the point, fraction digits and the exponent */
+#define FLOAT_BUF_SIZE      (20 + 1 + FLOAT_DIGITS_MAX + 6)
+
+#define FLOAT_NORMAL        0
+#define FLOAT_INF           1
+#define FLOAT_NAN           2
+
+/* split the magnitude of a double into m * 2^e */
+static int float_decompose(double value, rt_uint64_t *m, int *e, char *negative)
+{
+    union
+    {
+        double d;
+        rt_uint64_t u;
+    } bits;
+    int exp2;
+
+    bits.d = value;
+    *negative = (char)(bits.u >> 63);
+    exp2 = (int)(bits.u >> 52) & 0x7FF;
+    *m = bits.u & ((1ULL << 52) - 1);
+
+    if (exp2 == 0x7FF)
+        return *m ? FLOAT_NAN : FLOAT_INF;
+
+    if (exp2 == 0)
+    {
+        /* zero and subnormal */
+        *e = -1074;
+    }
+    else
+    {
+        *m |= 1ULL << 52;
+        *e = exp2 - 1075;
+    }
+
+    return FLOAT_NORMAL;
+}
+
+/*
+ * put the decimal digits of m * 2^e with precision fraction digits, rounded
+ * half to even, in integer arithmetic only. The fraction is frac / 2^k, with
+ * the high word in hi while k is above 60; a fraction below 2^-124 prints as
+ * zeros in any precision allowed.
+ *
+ * @return the length, or -1 when the integer part does not fit 64 bits
+ */
+static int float_fixed(char *tmp, rt_uint64_t m, int e, int precision)
+{
+    rt_uint64_t ipart, frac = 0, hi = 0, t, u, bit, rest;
+    rt_uint32_t ipart32;
+    char digits[FLOAT_DIGITS_MAX];
+    int k = 0, i, n, len = 0;
+
+    if (e >= 0)
+    {
+        if (e >= 64 || (e > 0 && (m >> (64 - e)) != 0))
+            return -1;
+        ipart = m << e;
+    }
+    else if (-e > 124)
+    {
+        ipart = 0;
+    }
+    else
+    {
+        k = -e;
+        /* m has 53 bits */
+        ipart = (k < 64) ? m >> k : 0;
+        frac = (k < 64) ? m & ((1ULL << k) - 1) : m;
+    }
+
+    n = precision < FLOAT_DIGITS_MAX ? precision : FLOAT_DIGITS_MAX;
+    for (i = 0; i < n; i++)
+    {
+        if (k > 60)
+        {
+            /* frac * 10 / 2^k as frac * 5 / 2^(k - 1) in 128 bits */
+            t = (frac & 0xFFFFFFFF) * 5;
+            u = (frac >> 32) * 5 + (t >> 32);
+            frac = (u << 32) | (t & 0xFFFFFFFF);
+            hi = hi * 5 + (u >> 32);
+            k--;
+
+            if (k >= 64)
+            {
+                digits[i] = (char)(hi >> (k - 64));
+                hi &= (1ULL << (k - 64)) - 1;
+            }
+            else
+            {
+                digits[i] = (char)((hi << (64 - k)) | (frac >> k));
+                hi = 0;
+                frac &= (1ULL << k) - 1;
+            }
+        }
+        else
+        {
+            frac *= 10;
+            digits[i] = (char)(frac >> k);
+            frac &= (1ULL << k) - 1;
+        }
+    }
+
+    /* round half to even on the bits left */
+    if (k > 0)
+    {
+        if (k > 64)
+        {
+            bit = (hi >> (k - 65)) & 1;
+            rest = (hi & ((1ULL << (k - 65)) - 1)) | frac;
+        }
+        else
+        {
+            bit = (frac >> (k - 1)) & 1;
+            rest = frac & ((1ULL << (k - 1)) - 1);
+        }
+
+        if (bit && (rest || ((n ? digits[n - 1] : (int)ipart) & 1)))
+        {
+            for (i = n - 1; i >= 0 && ++digits[i] == 10; i--)
+                digits[i] = 0;
+            if (i < 0)
+                ipart++;
+        }
+    }
+
+    /* the integer part, with 32 bit divisions as soon as it fits */
+    i = FLOAT_BUF_SIZE;
+    while (ipart >> 32)
+    {
+        tmp[--i] = '0' + (int)(ipart % 10);
+        ipart /= 10;
+    }
+    ipart32 = (rt_uint32_t)ipart;
+    do
+    {
+        tmp[--i] = '0' + ipart32 % 10;
+        ipart32 /= 10;
+    } while (ipart32);
+    while (i < FLOAT_BUF_SIZE)
+        tmp[len++] = tmp[i++];
+
+    if (n)
+    {
+        tmp[len++] = '.';
+        for (i = 0; i < n; i++)
+            tmp[len++] = '0' + digits[i];
+    }
+
+    return len;
+}
+
+/* scale a positive finite value into [1, 10), return the decimal exponent */
+static int float_exp10(double *value)
+{
+    static const double powers[] = {1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256};
+    double v = *value;
+    int x = 0, i;
+
+    if (v >= 10)
+    {
+        for (i = 8; i >= 0; i--)
+        {
+            if (v >= powers[i])
+            {
+                v /= powers[i];
+                x += 1 << i;
+            }
+        }
+    }
+    else if (v < 1)
+    {
+        for (i = 8; i >= 0; i--)
+        {
+            if (v * powers[i] < 10)
+            {
+                v *= powers[i];
+                x -= 1 << i;
+            }
+        }
+    }
+
+    /* the divisions may leave it just out of the range */
+    if (v >= 10)
+    {
+        v /= 10;
+        x++;
+    }
+    else if (v < 1)
+    {
+        v *= 10;
+        x--;
+    }
+
+    *value = v;
+    return x;
+}
+
+/* the digits of d.ddd with precision digits, return the length and the exponent */
+static int float_scientific(char *tmp, double value, int precision, int *exp10)
+{
+    rt_uint64_t m, n, q, rem;
+    int e, len, i, z;
+    char negative;
+
+    float_decompose(value, &m, &e, &negative);
+    if (value >= 1 && value < 18446744073709551616.0)
+    {
+        /* the integer part is exact, so is the exponent and the rounding */
+        n = (e >= 0) ? m << e : m >> -e;
+        for (*exp10 = 0, q = n; q >= 10; q /= 10)
+            (*exp10)++;
+
+        if (precision >= *exp10)
+        {
+            len = float_fixed(tmp, m, e, precision - *exp10);
+        }
+        else
+        {
+            for (q = 1, i = *exp10 - precision; i > 0; i--)
+                q *= 10;
+            rem = n % q;
+            n /= q;
+            if (rem > q / 2 || (rem == q / 2 && ((e < 0 && (m & ((1ULL << -e) - 1))) || (n & 1))))
+                n++;
+            len = float_fixed(tmp, n, 0, 0);
+        }
+    }
+    else
+    {
+        double scaled = value;
+
+        *exp10 = 0;
+        if (value != 0)
+            *exp10 = float_exp10(&scaled);
+
+        /*
+         * below 1 the fixed digits are exact as well when not too many; the
+         * exponent of the scaling may be one off, so it is checked on them
+         */
+        len = -1;
+        for (i = 0; value != 0 && value < 1 && i < 2 && precision - *exp10 <= FLOAT_DIGITS_MAX; i++)
+        {
+            len = float_fixed(tmp, m, e, precision - *exp10);
+            for (z = 0; z < len && (tmp[z] == '0' || tmp[z] == '.'); z++);
+            if (z < len && (z ? 1 - z : 0) == *exp10)
+            {
+                rt_memmove(&tmp[0], &tmp[z], len - z);
+                len -= z;
+                break;
+            }
+            *exp10 = (z < len) ? (z ? 1 - z : 0) : *exp10;
+            len = -1;
+        }
+
+        if (len < 0)
+        {
+            scaled = value;
+            *exp10 = (value != 0) ? float_exp10(&scaled) : 0;
+            float_decompose(scaled, &m, &e, &negative);
+            len = float_fixed(tmp, m, e, precision);
+        }
+    }
+
+    /* the digits only, one more when 9.99... rounded up to 10.00... */
+    for (i = 0; i < len && tmp[i] != '.'; i++);
+    if (i < len)
+    {
+        rt_memmove(&tmp[i], &tmp[i + 1], len - i - 1);
+        len--;
+    }
+    if (len > precision + 1)
+    {
+        len = precision + 1;
+        (*exp10)++;
+    }
+
+    if (precision)
+    {
+        rt_memmove(&tmp[2], &tmp[1], len - 1);
+        tmp[1] = '.';
+        len++;
+    }
+
+    return len;
+}
+
+static int float_exponent(char *tmp, int exp10, int upper)
+{
+    int len = 0;
+
+    tmp[len++] = upper ? 'E' : 'e';
+    if (exp10 < 0)
+    {
+        tmp[len++] = '-';
+        exp10 = -exp10;
+    }
+    else
+    {
+        tmp[len++] = '+';
+    }
+    if (exp10 >= 100)
+        tmp[len++] = '0' + exp10 / 100;
+    tmp[len++] = '0' + exp10 / 10 % 10;
+    tmp[len++] = '0' + exp10 % 10;
+
+    return len;
+}
+
+static char *print_float(char *buf,
+                         char *end,
+                         double value,
+                         char  fmt,
+                         int   s,
+                         int   precision,
+                         int   type)
+{
+    char tmp[FLOAT_BUF_SIZE];
+    char sign, negative, c;
+    int len, zeros = 0, exp10, upper, class, e, i;
+    rt_uint64_t m;
+
+    upper = (fmt == 'F' || fmt == 'E' || fmt == 'G');
+    fmt |= 0x20;
+    if (precision < 0)
+        precision = 6;
+    if (type & LEFT)
+        type &= ~ZEROPAD;
+
+    class = float_decompose(value, &m, &e, &negative);
+    if (negative)
+        value = -value;
+
+    if (class != FLOAT_NORMAL)
+    {
+        const char *name = (class == FLOAT_INF) ? (upper ? "INF" : "inf") : (upper ? "NAN" : "nan");
+
+        for (len = 0; len < 3; len++)
+            tmp[len] = name[len];
+        type &= ~ZEROPAD;
+    }
+    else if (fmt == 'g')
+    {
+        if (precision == 0)
+            precision = 1;
+        if (precision > FLOAT_DIGITS_MAX)
+            precision = FLOAT_DIGITS_MAX;
+
+        len = float_scientific(tmp, value, precision - 1, &exp10);
+        if (exp10 >= -4 && exp10 < precision)
+            len = float_fixed(tmp, m, e, precision - 1 - exp10);
+
+        /* no trailing zeros unless '#', which keeps the point as well */
+        for (i = 0; i < len && tmp[i] != '.'; i++);
+        if (type & SPECIAL)
+        {
+            if (i == len)
+                tmp[len++] = '.';
+        }
+        else if (i < len)
+        {
+            while (tmp[len - 1] == '0')
+                len--;
+            if (tmp[len - 1] == '.')
+                len--;
+        }
+
+        if (exp10 < -4 || exp10 >= precision)
+            len += float_exponent(&tmp[len], exp10, upper);
+    }
+    else
+    {
+        if (fmt == 'f')
+            len = float_fixed(tmp, m, e, precision);
+        else
+            len = -1;
+
+        /* %e, and %f of 2^64 and more */
+        if (len < 0)
+        {
+            if (precision > FLOAT_DIGITS_MAX)
+                precision = FLOAT_DIGITS_MAX;
+            len = float_scientific(tmp, value, precision, &exp10);
+            if (precision == 0 && (type & SPECIAL))
+                tmp[len++] = '.';
+            len += float_exponent(&tmp[len], exp10, upper);
+        }
+        else
+        {
+            if (precision == 0 && (type & SPECIAL))
+                tmp[len++] = '.';
+            if (precision > FLOAT_DIGITS_MAX)
+                zeros = precision - FLOAT_DIGITS_MAX;
+        }
+    }
+
+    sign = 0;
+    if (negative && class != FLOAT_NAN)
+        sign = '-';
+    else if (type & PLUS)
+        sign = '+';
+    else if (type & SPACE)
+        sign = ' ';
+
+    s -= len + zeros + (sign ? 1 : 0);
+    c = (type & ZEROPAD) ? '0' : ' ';
+
+    if (!(type & (ZEROPAD | LEFT)))
+    {
+        while (s-- > 0)
+        {
+            if (buf < end) *buf = ' ';
+            ++ buf;
+        }
+    }
+
+    if (sign)
+    {
+        if (buf < end) *buf = sign;
+        ++ buf;
+    }
+
+    if (!(type & LEFT))
+    {
+        while (s-- > 0)
+        {
+            if (buf < end) *buf = c;
+            ++ buf;
+        }
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        if (buf < end) *buf = tmp[i];
+        ++ buf;
+    }
+
+    while (zeros-- > 0)
+    {
+        if (buf < end) *buf = '0';
+        ++ buf;
+    }
+
+    while (s-- > 0)
+    {
+        if (buf < end) *buf = ' ';
+        ++ buf;
+    }
+
+    return buf;
+}
+#endif /* RT_PRINTF_FLOAT */
+
 rt_int32_t rt_vsnprintf(char       *buf,
                         rt_size_t   size,
                         const char *fmt,
@@ -964,6 +1432,21 @@ rt_int32_t rt_vsnprintf(char       *buf,
             ++ str;
             continue;
 
+#ifdef RT_PRINTF_FLOAT
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+#ifdef RT_PRINTF_PRECISION
+            str = print_float(str, end, va_arg(args, double), *fmt, field_width, precision, flags);
+#else
+            str = print_float(str, end, va_arg(args, double), *fmt, field_width, -1, flags);
+#endif
+            continue;
+#endif
+
         /* integer number formats - set up the flags and "break" */
         case 'o':
             base = 8;
@@ -1325,6 +1808,50 @@ int __rt_ffs(int value)
 }
 #endif
 
+#ifndef RT_USING_HW_ATOMIC
+/**
+ * This function compares the word at ptr with expected and, only if they are
+ * equal, stores desired to it, as one atomic operation.
+ *
+ * @return the value of the word before the operation
+ */
+rt_uint32_t rt_hw_atomic_cas(volatile rt_uint32_t *ptr, rt_uint32_t expected, rt_uint32_t desired)
+{
+    rt_base_t level;
+    rt_uint32_t old;
+
+    level = rt_hw_interrupt_disable();
+    old = *ptr;
+    if (old == expected)
+        *ptr = desired;
+    rt_hw_interrupt_enable(level);
+
+    return old;
+}
+
+/**
+ * This function adds value to the word at ptr as one atomic operation.
+ *
+ * @return the new value of the word
+ */
+rt_uint32_t rt_hw_atomic_add(volatile rt_uint32_t *ptr, rt_int32_t value)
+{
+    rt_base_t level;
+    rt_uint32_t result;
+
+    level = rt_hw_interrupt_disable();
+    result = *ptr + value;
+    *ptr = result;
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+
+void rt_hw_dmb(void)
+{
+}
+#endif
+
 #ifdef RT_DEBUG
 /* RT_ASSERT(EX)'s hook */
 void (*rt_assert_hook)(const char *ex, const char *func, rt_size_t line);
@@ -17,6 +17,7 @@
  * 2013-05-24     Bernard      fix the rt_memheap_realloc issue.
  * 2013-07-11     Grissiom     fix the memory block splitting issue.
  * 2013-07-15     Grissiom     optimize rt_memheap_realloc
+ * 2026-10-19     yqiu         add rt_malloc_region for placement hints.
  */
 
 #include <rthw.h>
@@ -647,6 +648,32 @@ void *rt_malloc(rt_size_t size)
 }
 RTM_EXPORT(rt_malloc);
 
+/**
+ * This function will allocate a block from the memory heap of a region
+ * first, e.g. a faster RAM for data of a control loop. When the region is
+ * full or does not exist, the block is allocated as by rt_malloc.
+ *
+ * @param region the name of the memory heap
+ * @param size the size of memory to be allocated
+ *
+ * @return the allocated memory
+ */
+void *rt_malloc_region(const char *region, rt_size_t size)
+{
+    void *ptr = RT_NULL;
+    struct rt_memheap *heap;
+
+    heap = (struct rt_memheap *)rt_object_find(region, RT_Object_Class_MemHeap);
+    if (heap != RT_NULL)
+        ptr = rt_memheap_alloc(heap, size);
+
+    if (ptr == RT_NULL)
+        ptr = rt_malloc(size);
+
+    return ptr;
+}
+RTM_EXPORT(rt_malloc_region);
+
 void rt_free(void *rmem)
 {
     rt_memheap_free(rmem);
@@ -14,6 +14,7 @@
  * 2010-10-26     yi.qiu       add module support in rt_mp_delete
  * 2011-01-24     Bernard      add object allocation check.
  * 2012-03-22     Bernard      fix align issue in rt_mp_init and rt_mp_create.
+ * 2026-10-19     yqiu         add magazine cache and size classes.
  */
 
 #include <rthw.h>
@@ -448,6 +449,345 @@ void rt_mp_free(void *block)
 }
 RTM_EXPORT(rt_mp_free);
 
+#ifdef RT_USING_MEMPOOL_MAGAZINE
+/*
+ * take up to count blocks from the pool with one critical section. The block
+ * header keeps pointing to the pool while a block is in a magazine.
+ */
+static rt_size_t _mp_take_blocks(rt_mp_t mp, void **blocks, rt_size_t count)
+{
+    rt_uint8_t *block_ptr;
+    register rt_base_t level;
+    rt_size_t index;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (index = 0; index < count && mp->block_free_count > 0; index ++)
+    {
+        mp->block_free_count --;
+
+        block_ptr = mp->block_list;
+        mp->block_list = *(rt_uint8_t **)block_ptr;
+        *(rt_uint8_t **)block_ptr = (rt_uint8_t *)mp;
+
+        blocks[index] = block_ptr + sizeof(rt_uint8_t *);
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return index;
+}
+
+/* give count blocks back to the pool with one critical section */
+static void _mp_put_blocks(rt_mp_t mp, void **blocks, rt_size_t count)
+{
+    rt_uint8_t **block_ptr;
+    struct rt_thread *thread;
+    register rt_base_t level;
+    rt_bool_t need_schedule = RT_FALSE;
+    rt_size_t index;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (index = 0; index < count; index ++)
+    {
+        block_ptr = (rt_uint8_t **)((rt_uint8_t *)blocks[index] - sizeof(rt_uint8_t *));
+
+        mp->block_free_count ++;
+        *block_ptr = mp->block_list;
+        mp->block_list = (rt_uint8_t *)block_ptr;
+
+        if (mp->suspend_thread_count > 0)
+        {
+            /* one suspended thread for every returned block */
+            thread = rt_list_entry(mp->suspend_thread.next,
+                                   struct rt_thread,
+                                   tlist);
+            thread->error = RT_EOK;
+            rt_thread_resume(thread);
+            mp->suspend_thread_count --;
+
+            need_schedule = RT_TRUE;
+        }
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    if (need_schedule == RT_TRUE)
+        rt_schedule();
+}
+
+/**
+ * This function will initialize a magazine, a small cache of blocks of a
+ * memory pool for one consumer.
+ *
+ * A magazine owned by a thread must only be used by this thread, and is then
+ * accessed without any lock. A magazine without owner may be used by all
+ * interrupt handlers, and masks interrupts since they nest, but only while
+ * block pointers are moved; refills and drains work on a local batch.
+ *
+ * @param mag the magazine
+ * @param mp the memory pool object
+ * @param owner the owner thread, RT_NULL for the interrupt magazine
+ */
+void rt_mp_magazine_init(rt_mp_magazine_t mag, rt_mp_t mp, rt_thread_t owner)
+{
+    RT_ASSERT(mag != RT_NULL);
+    RT_ASSERT(mp != RT_NULL);
+
+    mag->mp           = mp;
+    mag->owner        = owner;
+    mag->count        = 0;
+    mag->refill_count = 0;
+    mag->drain_count  = 0;
+}
+RTM_EXPORT(rt_mp_magazine_init);
+
+/**
+ * This function will give all cached blocks of a magazine back to its memory
+ * pool, e.g. before the owner thread exits.
+ *
+ * @param mag the magazine
+ */
+void rt_mp_magazine_flush(rt_mp_magazine_t mag)
+{
+    register rt_base_t level = 0;
+    void *batch[RT_MP_MAGAZINE_SIZE];
+    rt_uint16_t count;
+
+    RT_ASSERT(mag != RT_NULL);
+
+    if (mag->owner == RT_NULL)
+        level = rt_hw_interrupt_disable();
+
+    count = mag->count;
+    mag->count = 0;
+    rt_memcpy(batch, mag->blocks, count * sizeof(void *));
+
+    if (mag->owner == RT_NULL)
+        rt_hw_interrupt_enable(level);
+
+    _mp_put_blocks(mag->mp, batch, count);
+}
+RTM_EXPORT(rt_mp_magazine_flush);
+
+/**
+ * This function will allocate a block from a magazine, which is refilled with
+ * half of its size from the memory pool when it is empty.
+ *
+ * @param mag the magazine
+ * @param time the waiting time when the memory pool is empty as well
+ *
+ * @return the allocated memory block or RT_NULL on allocated failed
+ */
+void *rt_mp_magazine_alloc(rt_mp_magazine_t mag, rt_int32_t time)
+{
+    register rt_base_t level = 0;
+    void *batch[RT_MP_MAGAZINE_SIZE / 2];
+    void *block = RT_NULL;
+    rt_size_t count, index;
+
+    RT_ASSERT(mag != RT_NULL);
+    RT_ASSERT(mag->owner == RT_NULL || mag->owner == rt_thread_self());
+
+    if (mag->owner == RT_NULL)
+        level = rt_hw_interrupt_disable();
+
+    if (mag->count > 0)
+        block = mag->blocks[-- mag->count];
+
+    if (mag->owner == RT_NULL)
+        rt_hw_interrupt_enable(level);
+
+    if (block == RT_NULL)
+    {
+        /* refill from the pool, which keeps its own critical section */
+        count = _mp_take_blocks(mag->mp, batch, RT_MP_MAGAZINE_SIZE / 2);
+
+        /* the pool is empty too, wait on it */
+        if (count == 0)
+            return rt_mp_alloc(mag->mp, time);
+
+        block = batch[-- count];
+
+        if (mag->owner == RT_NULL)
+            level = rt_hw_interrupt_disable();
+
+        for (index = 0; index < count && mag->count < RT_MP_MAGAZINE_SIZE; index ++)
+            mag->blocks[mag->count ++] = batch[index];
+        mag->refill_count ++;
+
+        if (mag->owner == RT_NULL)
+            rt_hw_interrupt_enable(level);
+
+        /* an interrupt filled the magazine in the meantime */
+        if (index < count)
+            _mp_put_blocks(mag->mp, &batch[index], count - index);
+    }
+
+    RT_OBJECT_HOOK_CALL(rt_mp_alloc_hook, (mag->mp, block));
+
+    return block;
+}
+RTM_EXPORT(rt_mp_magazine_alloc);
+
+/**
+ * This function will release a block to a magazine, which drains half of its
+ * size to the memory pool when it is full.
+ *
+ * @param mag the magazine
+ * @param block the address of memory block, which belongs to the pool of the
+ *              magazine
+ */
+void rt_mp_magazine_free(rt_mp_magazine_t mag, void *block)
+{
+    register rt_base_t level = 0;
+    void *batch[RT_MP_MAGAZINE_SIZE - RT_MP_MAGAZINE_SIZE / 2];
+    rt_size_t count = 0;
+
+    RT_ASSERT(mag != RT_NULL);
+    RT_ASSERT(mag->owner == RT_NULL || mag->owner == rt_thread_self());
+    RT_ASSERT(*(rt_mp_t *)((rt_uint8_t *)block - sizeof(rt_uint8_t *)) == mag->mp);
+
+    /* do not keep blocks from threads waiting on the pool */
+    if (mag->mp->suspend_thread_count > 0)
+    {
+        rt_mp_free(block);
+        return;
+    }
+
+    RT_OBJECT_HOOK_CALL(rt_mp_free_hook, (mag->mp, block));
+
+    if (mag->owner == RT_NULL)
+        level = rt_hw_interrupt_disable();
+
+    if (mag->count == RT_MP_MAGAZINE_SIZE)
+    {
+        mag->count = RT_MP_MAGAZINE_SIZE / 2;
+        count = RT_MP_MAGAZINE_SIZE - mag->count;
+        rt_memcpy(batch, &(mag->blocks[mag->count]), count * sizeof(void *));
+        mag->drain_count ++;
+    }
+    mag->blocks[mag->count ++] = block;
+
+    if (mag->owner == RT_NULL)
+        rt_hw_interrupt_enable(level);
+
+    /* drain to the pool, which keeps its own critical section */
+    if (count > 0)
+        _mp_put_blocks(mag->mp, batch, count);
+}
+RTM_EXPORT(rt_mp_magazine_free);
+
+#ifdef RT_USING_HEAP
+/**
+ * This function will create the memory pools of a size class allocator. The
+ * blocks are released with rt_mp_free.
+ *
+ * @param sc the size class allocator
+ * @param name the name of the memory pools
+ * @param block_size the block size of every class, in increasing order
+ * @param block_count the count of blocks of every class
+ * @param class_num the number of classes
+ *
+ * @return RT_EOK on successful, -RT_ENOMEM on failed
+ */
+rt_err_t rt_mp_sizeclass_create(rt_mp_sizeclass_t sc,
+                                const char       *name,
+                                const rt_size_t  *block_size,
+                                const rt_size_t  *block_count,
+                                rt_uint8_t        class_num)
+{
+    rt_uint8_t index;
+
+    RT_ASSERT(sc != RT_NULL);
+    RT_ASSERT(class_num > 0 && class_num <= RT_MP_SIZECLASS_MAX);
+
+    sc->class_num = 0;
+    for (index = 0; index < class_num; index ++)
+    {
+        RT_ASSERT(index == 0 || block_size[index] > block_size[index - 1]);
+
+        sc->pools[index] = rt_mp_create(name, block_count[index], block_size[index]);
+        if (sc->pools[index] == RT_NULL)
+        {
+            rt_mp_sizeclass_delete(sc);
+
+            return -RT_ENOMEM;
+        }
+        sc->class_num ++;
+    }
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mp_sizeclass_create);
+
+/**
+ * This function will delete the memory pools of a size class allocator.
+ *
+ * @param sc the size class allocator
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_mp_sizeclass_delete(rt_mp_sizeclass_t sc)
+{
+    RT_ASSERT(sc != RT_NULL);
+
+    while (sc->class_num > 0)
+    {
+        sc->class_num --;
+        rt_mp_delete(sc->pools[sc->class_num]);
+    }
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mp_sizeclass_delete);
+
+/**
+ * This function will allocate a block from the smallest class which fits the
+ * size. When that class is empty, a larger class is used before waiting.
+ *
+ * @param sc the size class allocator
+ * @param size the size of the object
+ * @param time the waiting time on the smallest fitting class
+ *
+ * @return the allocated memory block or RT_NULL on allocated failed
+ */
+void *rt_mp_sizeclass_alloc(rt_mp_sizeclass_t sc, rt_size_t size, rt_int32_t time)
+{
+    rt_uint8_t first, index;
+    void *block;
+
+    RT_ASSERT(sc != RT_NULL);
+
+    for (first = 0; first < sc->class_num; first ++)
+    {
+        if (sc->pools[first]->block_size >= size)
+            break;
+    }
+    if (first == sc->class_num)
+        return RT_NULL;
+
+    for (index = first; index < sc->class_num; index ++)
+    {
+        if (sc->pools[index]->block_free_count == 0)
+            continue;
+
+        block = rt_mp_alloc(sc->pools[index], 0);
+        if (block != RT_NULL)
+            return block;
+    }
+
+    return rt_mp_alloc(sc->pools[first], time);
+}
+RTM_EXPORT(rt_mp_sizeclass_alloc);
+#endif
+#endif
+
 /**@}*/
 
 #endif
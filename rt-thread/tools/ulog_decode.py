@@ -0,0 +1,124 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2006-2018, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-19     yqiu         first version
+#
+# Rebuild the text of the ulog binary frames (ULOG_USING_BINARY).
+#
+# A frame is the 32-bit header (magic 0x11, level, argc), the tick, the tag
+# and format addresses and argc argument words, padded to RT_ALIGN_SIZE. The
+# strings are read from the firmware ELF file, so it must be the same build.
+# Text between the frames, e.g. the other logs of the file backend
+# (ULOG_FILE_BINARY), is printed as it is.
+#
+# usage: ulog_decode.py rtthread.elf log.bin
+
+import sys
+import re
+import struct
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument('elf', type=argparse.FileType('rb'), help='the firmware ELF file')
+parser.add_argument('log', type=argparse.FileType('rb'), help='the binary log frames')
+parser.add_argument('--align', type=int, default=4, help='RT_ALIGN_SIZE of the firmware, default to 4.')
+
+ULOG_BIN_FRAME_MAGIC = 0x11
+LEVEL_NAME = {0: 'A', 3: 'E', 4: 'W', 6: 'I', 7: 'D'}
+CONTROL = re.compile(r'[\x00-\x08\x0b-\x1f\x7f]')
+CONVERSION = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(l|ll|h|hh)?([diuxXcspo%])')
+
+class Image(object):
+    def __init__(self, elf):
+        from elftools.elf.elffile import ELFFile
+
+        self._sections = []
+        for section in ELFFile(elf).iter_sections():
+            if section['sh_addr'] and section['sh_type'] == 'SHT_PROGBITS':
+                self._sections.append((section['sh_addr'], section.data()))
+
+    def string(self, addr):
+        for base, data in self._sections:
+            if base <= addr < base + len(data):
+                end = data.find(b'\0', addr - base)
+                return data[addr - base:end].decode('utf-8', 'replace')
+        return '<0x%08x>' % addr
+
+def signed(word):
+    return word - (1 << 32) if word & 0x80000000 else word
+
+def format_log(image, fmt, args):
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, length, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if width == '*':
+            width = str(signed(args.pop(0))) if args else ''
+        if precision == '*':
+            precision = str(args.pop(0)) if args else ''
+        word = args.pop(0) if args else 0
+        spec = '%' + (flags or '') + (width or '') + ('.' + precision if precision else '')
+
+        if conv in 'di':
+            return (spec + 'd') % signed(word)
+        if conv == 'u':
+            return (spec + 'd') % word
+        if conv == 'c':
+            return (spec + 'c') % chr(word & 0xff)
+        if conv == 's':
+            return (spec + 's') % image.string(word)
+        if conv == 'p':
+            return '0x%08x' % word
+        return (spec + conv) % word
+
+    return CONVERSION.sub(convert, fmt)
+
+def text_lines(text):
+    # the padding and broken frames, e.g. of a power loss, are no text
+    for line in text.decode('utf-8', 'replace').splitlines():
+        line = line.strip('\0')
+        if line and not CONTROL.search(line):
+            yield line
+
+def decode(image, data, align):
+    """yield the lines of the frames and of the text between them"""
+    data = bytearray(data)
+    offset = 0
+    text = bytearray()
+
+    while offset < len(data):
+        if offset + 16 <= len(data):
+            header, tick, tag, fmt = struct.unpack_from('<IIII', data, offset)
+            magic, level, argc, reserved = header & 0xff, (header >> 8) & 0xff, (header >> 16) & 0xff, header >> 24
+            size = 16 + argc * 4
+            if magic == ULOG_BIN_FRAME_MAGIC and level in LEVEL_NAME and argc <= 8 and reserved == 0 \
+                    and offset + size <= len(data):
+                for line in text_lines(text):
+                    yield line
+                text = bytearray()
+
+                args = struct.unpack_from('<%dI' % argc, data, offset + 16)
+                offset += (size + align - 1) // align * align
+
+                yield '[%d] %s/%s: %s' % (tick, LEVEL_NAME[level], image.string(tag),
+                                          format_log(image, image.string(fmt), args))
+                continue
+
+        # not a frame, resynchronize on the next byte
+        text.append(data[offset])
+        offset += 1
+
+    for line in text_lines(text):
+        yield line
+
+if __name__ == '__main__':
+    args = parser.parse_args()
+    for line in decode(Image(args.elf), args.log.read(), args.align):
+        print(line)
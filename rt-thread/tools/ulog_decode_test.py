@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2006-2018, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-19     yqiu         first version
+#
+# Round trip of ulog binary frames through ulog_decode.py, the frames are
+# packed like struct ulog_bin_frame of a 32-bit little-endian firmware and
+# the file backend with ULOG_FILE_BINARY writes them.
+#
+# usage: python ulog_decode_test.py
+
+import struct
+import unittest
+
+import ulog_decode
+
+TAG, FORMAT, NAME = 0x08001000, 0x08001010, 0x08001040
+
+class FakeImage(object):
+    strings = {TAG: 'motor', FORMAT: 'speed %d rpm, %s ok, 0x%04x', NAME: 'left'}
+
+    def string(self, addr):
+        return self.strings.get(addr, '<0x%08x>' % addr)
+
+def frame(level, tick, tag, fmt, args, align=4):
+    data = struct.pack('<IIII', 0x11 | level << 8 | len(args) << 16, tick, tag, fmt)
+    data += struct.pack('<%dI' % len(args), *args)
+    return data + b'\0' * (-len(data) % align)
+
+class DecodeTest(unittest.TestCase):
+    def decode(self, data, align=4):
+        return list(ulog_decode.decode(FakeImage(), data, align))
+
+    def test_frame(self):
+        data = frame(6, 1234, TAG, FORMAT, [(-1500) & 0xffffffff, NAME, 0xbeef])
+        self.assertEqual(self.decode(data), ['[1234] I/motor: speed -1500 rpm, left ok, 0xbeef'])
+
+    def test_padding(self):
+        data = frame(3, 1, TAG, FORMAT, [7, NAME, 1], align=8) + frame(7, 2, TAG, FORMAT, [8, NAME, 2], align=8)
+        self.assertEqual(self.decode(data, align=8), ['[1] E/motor: speed 7 rpm, left ok, 0x0001',
+                                                      '[2] D/motor: speed 8 rpm, left ok, 0x0002'])
+
+    def test_text_between_frames(self):
+        data = b'[5] I/main: boot\r\n' + frame(4, 9, TAG, FORMAT, [3, NAME, 0]) + b'odd\n'
+        self.assertEqual(self.decode(data), ['[5] I/main: boot', '[9] W/motor: speed 3 rpm, left ok, 0x0000', 'odd'])
+
+    def test_truncated_frame(self):
+        data = frame(6, 1, TAG, FORMAT, [1, NAME, 1])
+        self.assertEqual(self.decode(data[:20]), [])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -45,11 +45,13 @@
 /* Memory Management */
 
 #define RT_USING_MEMPOOL
-/* RT_USING_MEMHEAP is not set */
+#define RT_USING_MEMPOOL_MAGAZINE
+#define RT_MP_MAGAZINE_SIZE 8
+#define RT_USING_MEMHEAP
 /* RT_USING_NOHEAP is not set */
-#define RT_USING_SMALL_MEM
+/* RT_USING_SMALL_MEM is not set */
 /* RT_USING_SLAB is not set */
-/* RT_USING_MEMTRACE is not set */
+#define RT_USING_MEMHEAP_AS_HEAP
 #define RT_USING_HEAP
 
 /* Kernel Device Object */
@@ -60,9 +62,12 @@
 #define RT_USING_CONSOLE
 #define RT_CONSOLEBUF_SIZE 256
 #define RT_CONSOLE_DEVICE_NAME "uart1"
+#define RT_PRINTF_FLOAT
 #define RT_VER_NUM 0x30104
 #define ARCH_ARM
 #define ARCH_ARM_CORTEX_M
+#define RT_USING_HW_ATOMIC
+#define RT_USING_HW_MEMCPY
 #define ARCH_ARM_CORTEX_M4
 /* ARCH_CPU_STACK_GROWS_UPWARD is not set */
 
@@ -72,6 +77,11 @@
 #define RT_USING_USER_MAIN
 #define RT_MAIN_THREAD_STACK_SIZE 2048
 #define RT_MAIN_THREAD_PRIORITY 10
+#define RT_USING_INIT_PROFILE
+#define RT_USING_INIT_ASYNC
+#define RT_INIT_ASYNC_WORKERS 2
+#define RT_INIT_ASYNC_STACK_SIZE 2048
+#define RT_INIT_ASYNC_PRIORITY 24
 
 /* C++ features */
 
@@ -94,6 +104,7 @@
 #define FINSH_USING_MSH_DEFAULT
 #define FINSH_USING_MSH_ONLY
 #define FINSH_ARG_MAX 10
+#define FINSH_CMD_INDEX_MAX 128
 
 /* Device virtual file system */
 
@@ -103,6 +114,7 @@
 
 #define RT_USING_DEVICE_IPC
 #define RT_PIPE_BUFSZ 512
+#define RT_WORKQUEUE_DELAYED_MAX 16
 /* RT_USING_SYSTEM_WORKQUEUE is not set */
 #define RT_USING_SERIAL
 #define RT_SERIAL_USING_DMA
@@ -365,6 +377,8 @@
 /* On-chip Peripheral Drivers */
 
 #define BSP_USING_GPIO
+#define BSP_USING_SOFTIRQ
+#define BSP_USING_SRAM2
 #define BSP_USING_UART
 #define BSP_USING_UART1
 /* BSP_UART1_RX_USING_DMA is not set */
@@ -394,7 +408,9 @@
 #define BSP_USING_PWM4
 #define BSP_USING_PWM4_CH3
 #define BSP_USING_PWM4_CH4
-/* BSP_USING_ADC is not set */
+#define BSP_USING_ADC
+#define BSP_USING_ADC1
+#define BSP_ADC1_BATTERY_CHANNEL 14
 /* BSP_USING_ONCHIP_RTC is not set */
 /* BSP_USING_WDT is not set */
 